@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Builds gfx.dat and sfx.dat from the files in data/, run from the top of the repository. The
+# archives hold what the scenes load (see SceneManager::getManifest) and nothing else, add a file
+# here when a scene starts using it.
+
+set -e
+
+GFX="data/gfx/playfield.png"
+for shape in t s z i j l o; do
+  GFX="$GFX data/gfx/mino_$shape.png data/gfx/mino_ghost_$shape.png"
+done
+
+SFX="data/sfx/move_new.wav data/sfx/rotate_new.wav data/sfx/soundss.wav"
+
+rm -f gfx.dat sfx.dat
+zip -X -D -q gfx.dat $GFX
+zip -X -D -q sfx.dat $SFX
@@ -0,0 +1,53 @@
+#include "allocation_counter.h"
+
+#ifdef RIKTRIS_COUNT_ALLOCATIONS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<long> allocationCount{0};
+
+void *operator new(size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+  void *pointer = malloc(size > 0 ? size : 1);
+  if (!pointer) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void *operator new(size_t size, std::align_val_t alignment) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+  // aligned_alloc wants the size to be a multiple of the alignment
+  size_t align = (size_t)alignment;
+  void *pointer = aligned_alloc(align, (size + align - 1) / align * align);
+  if (!pointer) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+void *operator new[](size_t size, std::align_val_t alignment) {
+  return operator new(size, alignment);
+}
+
+void operator delete(void *pointer) noexcept { free(pointer); }
+void operator delete(void *pointer, size_t) noexcept { free(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { free(pointer); }
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept { free(pointer); }
+void operator delete[](void *pointer) noexcept { free(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { free(pointer); }
+void operator delete[](void *pointer, std::align_val_t) noexcept { free(pointer); }
+void operator delete[](void *pointer, size_t, std::align_val_t) noexcept { free(pointer); }
+
+long getAllocationCount() { return allocationCount.load(std::memory_order_relaxed); }
+
+#else
+
+long getAllocationCount() { return -1; }
+
+#endif
@@ -0,0 +1,11 @@
+#pragma once
+
+// Counts every heap allocation of the program, to catch the ones made while playing. Allocating
+// in the middle of a frame makes its time unpredictable, once a game is under way there should be
+// none at all.
+//
+// Counting replaces the global operator new, so it's only compiled in debug builds (or with
+// -DRIKTRIS_COUNT_ALLOCATIONS=ON).
+
+// Allocations made so far, or -1 if they aren't being counted in this build
+long getAllocationCount();
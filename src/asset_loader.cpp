@@ -0,0 +1,146 @@
+#include "asset_loader.h"
+#include "core/asset_pack.h"
+#include "startup_trace.h"
+#include "utils.h"
+#include <iostream>
+#include <physfs.h>
+
+// Mapped for as long as the game runs, the sounds and images are used straight from it
+static AssetPack pack;
+
+void mountAssets() {
+  must_init(PHYSFS_init(NULL), "PHYSFS engine");
+
+  // The pack is optional, without it everything is decoded from the archives. It goes with the
+  // executable, wherever that is installed.
+  {
+    StartupSpan span("map " ASSET_PACK_FILE, "assets");
+    std::string packPath = std::string(PHYSFS_getBaseDir()) + ASSET_PACK_FILE;
+
+    if (pack.open(packPath)) {
+      std::cout << "Using " << pack.getEntries().size() << " baked assets from " << packPath
+                << std::endl;
+    }
+  }
+
+  for (const char *archive : ASSET_ARCHIVES) {
+    StartupSpan span(std::string("mount ") + archive, "assets");
+    must_init(PHYSFS_mount(archive, NULL, 1), archive);
+  }
+
+  // Loose files in the data directory, for whatever the archives don't have
+  StartupSpan span("mount data directory", "assets");
+  must_init(PHYSFS_mount(".", NULL, 1), "data directory");
+}
+
+bool readAsset(const std::string &path, std::vector<unsigned char> &data) {
+  PHYSFS_File *file = PHYSFS_openRead(path.c_str());
+
+  if (!file) {
+    std::cerr << "Could not open " << path << ": "
+              << PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode()) << std::endl;
+    return false;
+  }
+
+  PHYSFS_sint64 length = PHYSFS_fileLength(file);
+  data.resize(length > 0 ? length : 0);
+
+  bool ok = length >= 0 && PHYSFS_readBytes(file, data.data(), data.size()) == length;
+  PHYSFS_close(file);
+
+  if (!ok) {
+    std::cerr << "Could not read " << path << std::endl;
+  }
+  return ok;
+}
+
+static std::string getExtension(const std::string &path) {
+  size_t dot = path.rfind('.');
+  return dot == std::string::npos ? "" : path.substr(dot);
+}
+
+// The image in the pack, pointing into the mapping: it must not be unloaded
+static bool findPackedImage(const std::string &path, Image &image) {
+  const AssetPackEntry *entry = pack.find(path);
+
+  if (!entry || entry->kind != ASSET_IMAGE) {
+    return false;
+  }
+
+  image.data = (void *)pack.getData(*entry);
+  image.width = entry->params[0];
+  image.height = entry->params[1];
+  image.format = entry->params[2];
+  image.mipmaps = entry->params[3];
+  return true;
+}
+
+bool isAssetPacked(const std::string &path) { return pack.find(path) != nullptr; }
+
+Image loadImageAsset(const std::string &path) {
+  Image packed;
+
+  // The caller owns (and unloads) the image, so it gets a copy
+  if (findPackedImage(path, packed)) {
+    return ImageCopy(packed);
+  }
+
+  std::vector<unsigned char> data;
+
+  if (!readAsset(path, data)) {
+    return {};
+  }
+  return LoadImageFromMemory(getExtension(path).c_str(), data.data(), (int)data.size());
+}
+
+Texture2D loadTextureAsset(const std::string &path) {
+  Image packed;
+
+  if (findPackedImage(path, packed)) {
+    return LoadTextureFromImage(packed);
+  }
+
+  Image image = loadImageAsset(path);
+
+  if (!image.data) {
+    return {};
+  }
+
+  Texture2D texture = LoadTextureFromImage(image);
+  UnloadImage(image);
+  return texture;
+}
+
+// Only the archives, sounds in the pack are used straight from it by loadSoundAsset
+Wave loadWaveAsset(const std::string &path) {
+  std::vector<unsigned char> data;
+
+  if (!readAsset(path, data)) {
+    return {};
+  }
+  return LoadWaveFromMemory(getExtension(path).c_str(), data.data(), (int)data.size());
+}
+
+Sound loadSoundAsset(const std::string &path) {
+  const AssetPackEntry *entry = pack.find(path);
+
+  if (entry && entry->kind == ASSET_SOUND) {
+    Wave wave;
+    wave.frameCount = entry->params[0];
+    wave.sampleRate = entry->params[1];
+    wave.sampleSize = entry->params[2];
+    wave.channels = entry->params[3];
+    wave.data = (void *)pack.getData(*entry);
+
+    return LoadSoundFromWave(wave);
+  }
+
+  Wave wave = loadWaveAsset(path);
+  if (!wave.data) {
+    return {};
+  }
+
+  Sound sound = LoadSoundFromWave(wave);
+  UnloadWave(wave);
+  return sound;
+}
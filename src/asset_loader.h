@@ -0,0 +1,43 @@
+#pragma once
+
+#include <raylib.h>
+#include <string>
+#include <vector>
+
+// Every asset is read through PhysFS, by its path in the data directory ("data/gfx/mino_t.png").
+// The .dat archives are searched first, then the data directory itself, so loose files work for
+// anything that isn't packed yet.
+//
+// Mounting an archive only reads its directory, the entries are read when they are loaded. The
+// archives hold just what the scenes load, so the few files opened at startup are all there is to
+// read, instead of a file for every texture and sound.
+//
+// Before any of that, images and sounds are looked up in ASSET_PACK_FILE, baked by the build
+// (see core/asset_pack.h). Those don't need decoding, they are uploaded straight from the mapped
+// file.
+
+// Next to the executable, where the build writes it
+#define ASSET_PACK_FILE "assets.pak"
+
+// The archives mounted at startup, in the order they are searched
+inline const char *ASSET_ARCHIVES[] = {"gfx.dat", "sfx.dat", "misc.dat"};
+
+// Maps the asset pack if there is one, starts PhysFS and mounts the archives and the current
+// directory. Exits if an archive can't be read, like the rest of the startup checks.
+void mountAssets();
+
+// Reads a whole file into data. Returns false (and prints why) if it can't be read.
+bool readAsset(const std::string &path, std::vector<unsigned char> &data);
+
+// Whether the asset is in the pack, so loading it doesn't need any decoding
+bool isAssetPacked(const std::string &path);
+
+// Decoded from memory, the file extension tells raylib the format. Empty (zero sized) if the file
+// can't be read or decoded, like the raylib functions loading from a path.
+//
+// Reading and decoding images and waves can be done from any thread. Textures and sounds are
+// uploaded to the GPU / audio device, which only the main thread can do.
+Image loadImageAsset(const std::string &path);
+Wave loadWaveAsset(const std::string &path);
+Texture2D loadTextureAsset(const std::string &path);
+Sound loadSoundAsset(const std::string &path);
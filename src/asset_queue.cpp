@@ -0,0 +1,160 @@
+#include "asset_queue.h"
+#include "asset_loader.h"
+#include "sound_manager.h"
+#include "startup_trace.h"
+#include "texture_manager.h"
+#include <chrono>
+
+AssetQueue &AssetQueue::getInstance() {
+  static AssetQueue instance;
+  return instance;
+}
+
+AssetQueue::~AssetQueue() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  jobAdded.notify_all();
+
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  // Never uploaded, the game is closing
+  for (Job &job : decoded) {
+    UnloadImage(job.image);
+    UnloadWave(job.wave);
+  }
+}
+
+void AssetQueue::request(const AssetManifest &manifest) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (const std::string &filename : manifest.textures) {
+      waiting.push_back({TEXTURE, filename, false, {}, {}});
+    }
+    for (const std::string &filename : manifest.images) {
+      waiting.push_back({IMAGE, filename, false, {}, {}});
+    }
+    for (const std::string &filename : manifest.sounds) {
+      waiting.push_back({SOUND, filename, false, {}, {}});
+    }
+
+    // The threads are only started the first time there is something to load
+    while (workers.size() < ASSET_QUEUE_THREADS) {
+      workers.emplace_back(&AssetQueue::work, this);
+    }
+  }
+  jobAdded.notify_all();
+}
+
+void AssetQueue::work() {
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while (true) {
+    jobAdded.wait(lock, [&]() { return stopping || !waiting.empty(); });
+    if (stopping) {
+      return;
+    }
+
+    Job job = waiting.front();
+    waiting.pop_front();
+    decoding++;
+    lock.unlock();
+
+    {
+      StartupSpan span("decode " + job.filename, "decode");
+
+      if (job.kind == TEXTURE) {
+        std::string path = TEXTURES_DIR + job.filename;
+        job.packed = isAssetPacked(path);
+        if (!job.packed) {
+          job.image = loadImageAsset(path);
+        }
+      } else if (job.kind == IMAGE) {
+        // Packed or not, the atlas needs its own copy of the pixels
+        job.image = loadImageAsset(TEXTURES_DIR + job.filename);
+      } else {
+        std::string path = SOUND_DIR + job.filename;
+        job.packed = isAssetPacked(path);
+        if (!job.packed) {
+          job.wave = loadWaveAsset(path);
+        }
+      }
+    }
+
+    lock.lock();
+    decoded.push_back(job);
+    decoding--;
+    jobDecoded.notify_all();
+  }
+}
+
+void AssetQueue::uploadJob(Job &job) {
+  // The managers load packed assets (and the ones that failed to decode, to report it) themselves
+  if (job.kind == TEXTURE) {
+    if (job.packed || !job.image.data) {
+      TextureManager::getInstance().loadTexture(job.filename);
+    } else {
+      TextureManager::getInstance().addTexture(job.filename, job.image);
+      UnloadImage(job.image);
+    }
+  } else if (job.kind == IMAGE) {
+    // Kept by TextureManager until an atlas uses it. If it failed, the atlas loads it (and reports
+    // it) itself.
+    if (job.image.data) {
+      TextureManager::getInstance().addImage(job.filename, job.image);
+    }
+  } else {
+    if (job.packed || !job.wave.data) {
+      SoundManager::getInstance().loadSound(job.filename);
+    } else {
+      SoundManager::getInstance().addSound(job.filename, job.wave);
+      UnloadWave(job.wave);
+    }
+  }
+}
+
+int AssetQueue::upload(double budgetMillis) {
+  auto start = std::chrono::steady_clock::now();
+  int count = 0;
+
+  while (std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+             .count() < budgetMillis) {
+    Job job;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (decoded.empty()) {
+        break;
+      }
+      job = decoded.front();
+      decoded.pop_front();
+    }
+
+    uploadJob(job);
+    count++;
+  }
+  return count;
+}
+
+void AssetQueue::finish() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      jobDecoded.wait(lock, [&]() {
+        return !decoded.empty() || (waiting.empty() && decoding == 0);
+      });
+
+      if (decoded.empty()) {
+        return;
+      }
+      job = decoded.front();
+      decoded.pop_front();
+    }
+
+    uploadJob(job);
+  }
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <raylib.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Threads reading and decoding assets in the background
+#define ASSET_QUEUE_THREADS 2
+
+// Longest the main loop spends uploading decoded assets in a frame (milliseconds)
+#define ASSET_UPLOAD_BUDGET_MS 2.0
+
+// The assets a scene needs, so they can be loaded before it starts
+struct AssetManifest {
+  std::vector<std::string> textures; // In TEXTURES_DIR
+  std::vector<std::string> images;   // In TEXTURES_DIR, only decoded, for atlases
+  std::vector<std::string> sounds;   // In SOUND_DIR
+};
+
+// Loads assets in the background. Worker threads read and decode the files, then the main thread
+// uploads them to the GPU and the audio device (only it can) and hands them to TextureManager and
+// SoundManager, a few at a time every frame. Whatever is loaded this way is already there when a
+// scene asks for it, so nothing is read from disk in the middle of a frame.
+class AssetQueue {
+private:
+  enum Kind { TEXTURE, IMAGE, SOUND };
+
+  struct Job {
+    Kind kind;
+    std::string filename;
+    bool packed; // In the asset pack, nothing to decode
+    Image image;
+    Wave wave;
+  };
+
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable jobAdded;
+  std::condition_variable jobDecoded;
+  std::deque<Job> waiting;
+  std::deque<Job> decoded;
+  int decoding = 0; // Jobs taken by a worker and not finished yet
+  bool stopping = false;
+
+  AssetQueue() = default;
+
+  void work();
+  void uploadJob(Job &job);
+
+public:
+  static AssetQueue &getInstance();
+  ~AssetQueue();
+
+  AssetQueue(const AssetQueue &) = delete;
+  AssetQueue &operator=(const AssetQueue &) = delete;
+
+  // Starts loading everything in the manifest. Can be called before the window and the audio
+  // device exist, only the uploads need them.
+  void request(const AssetManifest &manifest);
+
+  // Main thread, once per frame: uploads decoded assets until the budget is used up. Returns how
+  // many were uploaded.
+  int upload(double budgetMillis);
+
+  // Main thread: waits for everything requested and uploads all of it
+  void finish();
+};
@@ -0,0 +1,142 @@
+#include "asset_pack.h"
+#include "byte_stream.h"
+#include <algorithm>
+#include <cstdio>
+
+static uint64_t alignUp(uint64_t value) {
+  return (value + ASSET_PACK_ALIGNMENT - 1) / ASSET_PACK_ALIGNMENT * ASSET_PACK_ALIGNMENT;
+}
+
+// The index takes the same room whatever the offsets are, so it can be measured before they are
+// known
+static void writeIndex(ByteWriter &writer, const std::vector<AssetPackEntry> &entries) {
+  writer.putU32(ASSET_PACK_MAGIC);
+  writer.putU32(ASSET_PACK_VERSION);
+  writer.putU32(entries.size());
+
+  for (const AssetPackEntry &entry : entries) {
+    writer.putU16(entry.name.size());
+    writer.putBytes((const uint8_t *)entry.name.data(), entry.name.size());
+    writer.putU8(entry.kind);
+    for (uint32_t param : entry.params) {
+      writer.putU32(param);
+    }
+    writer.putU64(entry.offset);
+    writer.putU64(entry.size);
+  }
+}
+
+void AssetPackWriter::add(const std::string &name, ASSET_KIND kind, const uint32_t params[4],
+                          const void *data, size_t size) {
+  AssetPackEntry entry = {name, kind, {params[0], params[1], params[2], params[3]}, 0, size};
+
+  entries.push_back(entry);
+  contents.emplace_back((const uint8_t *)data, (const uint8_t *)data + size);
+}
+
+bool AssetPackWriter::write(const std::string &path) {
+  // Sorted, so the reader can search the index
+  std::vector<size_t> order(entries.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(),
+            [&](size_t a, size_t b) { return entries[a].name < entries[b].name; });
+
+  std::vector<AssetPackEntry> sorted;
+  for (size_t i : order) {
+    sorted.push_back(entries[i]);
+  }
+
+  ByteWriter index;
+  writeIndex(index, sorted);
+
+  uint64_t offset = alignUp(index.size());
+  for (AssetPackEntry &entry : sorted) {
+    entry.offset = offset;
+    offset = alignUp(offset + entry.size);
+  }
+
+  index.clear();
+  writeIndex(index, sorted);
+
+  FILE *file = fopen(path.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+
+  bool ok = fwrite(index.bytes(), 1, index.size(), file) == index.size();
+  uint64_t position = index.size();
+  const uint8_t padding[ASSET_PACK_ALIGNMENT] = {0};
+
+  for (size_t i = 0; i < sorted.size() && ok; i++) {
+    const AssetPackEntry &entry = sorted[i];
+    const std::vector<uint8_t> &content = contents[order[i]];
+
+    ok = fwrite(padding, 1, entry.offset - position, file) == entry.offset - position &&
+         fwrite(content.data(), 1, content.size(), file) == content.size();
+    position = entry.offset + entry.size;
+  }
+
+  return fclose(file) == 0 && ok;
+}
+
+bool AssetPack::open(const std::string &path) {
+  entries.clear();
+
+  if (!file.open(path)) {
+    return false;
+  }
+
+  ByteReader reader(file.getData(), file.getSize());
+
+  if (reader.getU32() != ASSET_PACK_MAGIC || reader.getU32() != ASSET_PACK_VERSION) {
+    file.close();
+    return false;
+  }
+
+  uint32_t count = reader.getU32();
+  bool valid = true;
+
+  for (uint32_t i = 0; i < count && valid; i++) {
+    AssetPackEntry entry;
+
+    size_t nameSize = reader.getU16();
+    const char *name = (const char *)reader.position();
+    reader.skip(nameSize);
+    if (reader.hasFailed()) {
+      break;
+    }
+
+    entry.name.assign(name, nameSize);
+    entry.kind = (ASSET_KIND)reader.getU8();
+    for (uint32_t &param : entry.params) {
+      param = reader.getU32();
+    }
+    entry.offset = reader.getU64();
+    entry.size = reader.getU64();
+
+    // Data outside of the file means the pack is damaged (or cut short), don't trust any of it
+    valid = entry.offset <= file.getSize() && entry.size <= file.getSize() - entry.offset;
+    entries.push_back(entry);
+  }
+
+  if (!valid || reader.hasFailed()) {
+    entries.clear();
+    file.close();
+    return false;
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const AssetPackEntry &a, const AssetPackEntry &b) { return a.name < b.name; });
+  return true;
+}
+
+const AssetPackEntry *AssetPack::find(const std::string &name) const {
+  auto it = std::lower_bound(entries.begin(), entries.end(), name,
+                             [](const AssetPackEntry &entry, const std::string &name) {
+                               return entry.name < name;
+                             });
+
+  return it != entries.end() && it->name == name ? &*it : nullptr;
+}
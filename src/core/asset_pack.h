@@ -0,0 +1,63 @@
+#pragma once
+
+#include "mapped_file.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A pack of assets decoded at build time (see tools/pack_assets.cpp), so the game can use them
+// without decoding anything. Images are stored as raw pixels and sounds as raw PCM samples, in the
+// format the decoder gave them, ready to upload straight from the mapped file.
+//
+// Layout: a header and an index (ByteWriter numbers, little-endian), then the data of every asset,
+// each one starting at a multiple of ASSET_PACK_ALIGNMENT. The data itself is in the byte order of
+// the machine that built the pack, it's meant to be built along with the game.
+
+#define ASSET_PACK_MAGIC 0x4B504B52 // "RKPK"
+#define ASSET_PACK_VERSION 1
+#define ASSET_PACK_ALIGNMENT 64
+
+typedef enum ASSET_KIND { ASSET_IMAGE = 0, ASSET_SOUND } ASSET_KIND;
+
+struct AssetPackEntry {
+  std::string name; // Path in the data directory, e.g. "data/gfx/mino_t.png"
+  ASSET_KIND kind;
+  // Images: width, height, pixel format (a raylib PixelFormat), mipmaps
+  // Sounds: frame count, sample rate, sample size in bits, channels
+  uint32_t params[4];
+  uint64_t offset; // From the start of the file
+  uint64_t size;
+};
+
+// Collects assets and writes them as a pack
+class AssetPackWriter {
+private:
+  std::vector<AssetPackEntry> entries;
+  std::vector<std::vector<uint8_t>> contents;
+
+public:
+  void add(const std::string &name, ASSET_KIND kind, const uint32_t params[4], const void *data,
+           size_t size);
+  bool write(const std::string &path);
+
+  size_t getCount() const { return entries.size(); }
+};
+
+// A pack, mapped into memory. Opening it only reads the index, the data of an asset is read by the
+// OS when it's used. The mapping is read-only, so every game running on a machine shares the pages.
+class AssetPack {
+private:
+  MappedFile file;
+  std::vector<AssetPackEntry> entries; // Sorted by name
+
+public:
+  bool open(const std::string &path);
+  bool isOpen() const { return file.isOpen(); }
+
+  // nullptr if the pack doesn't have it
+  const AssetPackEntry *find(const std::string &name) const;
+  const uint8_t *getData(const AssetPackEntry &entry) const { return file.getData() + entry.offset; }
+
+  const std::vector<AssetPackEntry> &getEntries() const { return entries; }
+};
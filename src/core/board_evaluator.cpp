@@ -0,0 +1,237 @@
+#include "board_evaluator.h"
+#include <fstream>
+
+static int countBits(uint32_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcount(value);
+#else
+  int count = 0;
+  for (; value; value &= value - 1) {
+    count++;
+  }
+  return count;
+#endif
+}
+
+// Pairs of neighbouring bits from the left wall to the right wall. A row xor itself shifted by one
+// has a bit set here for every change from filled to empty or back.
+#define ROW_TRANSITION_PAIRS 0x1FFCu
+
+BoardFeatures computeFeatures(const MinoGrid &grid) {
+  BoardFeatures features;
+  int heights[GRID_WIDTH] = {0};
+  uint16_t covered = 0; // Columns that already have a square above the current row
+
+  for (int row = 0; row < GRID_HEIGHT; row++) {
+    uint16_t mask = grid.getRowMask(row);
+    uint16_t field = mask & ROW_FIELD;
+    uint16_t below = row + 1 < GRID_HEIGHT ? grid.getRowMask(row + 1) : ROW_FULL;
+
+    features.columnTransitions += countBits((mask ^ below) & ROW_FIELD);
+
+    if (!field && !covered) {
+      continue; // Still above the stack
+    }
+
+    features.holes += countBits(~field & covered & ROW_FIELD);
+    features.rowTransitions += countBits((mask ^ (mask >> 1)) & ROW_TRANSITION_PAIRS);
+
+    // The first square of a column sets its height
+    uint16_t tops = field & ~covered;
+    if (tops) {
+      for (int col = 0; col < GRID_WIDTH; col++) {
+        if (tops & COLUMN_BIT(col)) {
+          heights[col] = GRID_HEIGHT - row;
+        }
+      }
+      covered |= field;
+    }
+  }
+
+  for (int col = 0; col < GRID_WIDTH; col++) {
+    features.aggregateHeight += heights[col];
+
+    if (col + 1 < GRID_WIDTH) {
+      int difference = heights[col] - heights[col + 1];
+      features.bumpiness += difference < 0 ? -difference : difference;
+    }
+
+    // The walls are as high as the playfield
+    int left = col > 0 ? heights[col - 1] : GRID_HEIGHT;
+    int right = col + 1 < GRID_WIDTH ? heights[col + 1] : GRID_HEIGHT;
+    int depth = (left < right ? left : right) - heights[col];
+
+    if (depth > 0) {
+      features.wells += depth;
+    }
+  }
+
+  return features;
+}
+
+float evaluateBoard(const MinoGrid &grid, int linesCleared, const EvaluatorWeights &weights) {
+  BoardFeatures features = computeFeatures(grid);
+
+  return weights.aggregateHeight * features.aggregateHeight + weights.holes * features.holes +
+         weights.bumpiness * features.bumpiness + weights.wells * features.wells +
+         weights.rowTransitions * features.rowTransitions +
+         weights.columnTransitions * features.columnTransitions + weights.lineClears[linesCleared];
+}
+
+static const char *const WEIGHT_NAMES[EVALUATOR_WEIGHT_COUNT] = {
+    "aggregateHeight", "holes",       "bumpiness",   "wells",       "rowTransitions",
+    "columnTransitions", "lineClears0", "lineClears1", "lineClears2", "lineClears3",
+    "lineClears4"};
+
+float &getWeight(EvaluatorWeights &weights, int index) {
+  float *features[] = {&weights.aggregateHeight, &weights.holes,
+                       &weights.bumpiness,       &weights.wells,
+                       &weights.rowTransitions,  &weights.columnTransitions};
+
+  return index < 6 ? *features[index] : weights.lineClears[index - 6];
+}
+
+const char *getWeightName(int index) { return WEIGHT_NAMES[index]; }
+
+bool loadEvaluatorWeights(const std::string &path, EvaluatorWeights &weights) {
+  std::ifstream file(path);
+  if (!file) {
+    return false;
+  }
+
+  std::string name;
+  float value;
+
+  while (file >> name >> value) {
+    int index = 0;
+    while (index < EVALUATOR_WEIGHT_COUNT && name != WEIGHT_NAMES[index]) {
+      index++;
+    }
+
+    if (index == EVALUATOR_WEIGHT_COUNT) {
+      return false;
+    }
+    getWeight(weights, index) = value;
+  }
+
+  return file.eof();
+}
+
+bool saveEvaluatorWeights(const std::string &path, const EvaluatorWeights &weights) {
+  std::ofstream file(path);
+  if (!file) {
+    return false;
+  }
+
+  EvaluatorWeights copy = weights;
+  for (int i = 0; i < EVALUATOR_WEIGHT_COUNT; i++) {
+    file << WEIGHT_NAMES[i] << " " << getWeight(copy, i) << "\n";
+  }
+
+  return (bool)file;
+}
+
+int BoardBatch::add(const MinoGrid &grid, int lines) {
+  for (int row = 0; row < GRID_HEIGHT; row++) {
+    rows[row][count] = grid.getRowMask(row);
+  }
+  linesCleared[count] = lines;
+
+  return count++;
+}
+
+// Bit count of a 16 bit value with plain arithmetic, so it can be done on many values at once
+static inline uint16_t countBits16(uint16_t value) {
+  value = value - ((value >> 1) & 0x5555);
+  value = (value & 0x3333) + ((value >> 2) & 0x3333);
+  value = (value + (value >> 4)) & 0x0F0F;
+  return (value + (value >> 8)) & 0x1F;
+}
+
+// Every loop over the boards below is branch free and only touches consecutive values, so that it
+// can be vectorized. Everything is computed for the whole batch, full or not.
+void computeBatchFeatures(const BoardBatch &batch, BatchFeatures &features) {
+  const int size = BOARD_BATCH_SIZE;
+  uint16_t covered[size] = {0};
+  uint16_t floor[size];    // Below the last row
+  int16_t wallHeight[size]; // Next to the first and last columns
+
+  for (int board = 0; board < size; board++) {
+    floor[board] = ROW_FULL;
+    wallHeight[board] = GRID_HEIGHT;
+  }
+
+  for (int col = 0; col < GRID_WIDTH; col++) {
+    for (int board = 0; board < size; board++) {
+      features.heights[col][board] = 0;
+    }
+  }
+
+  for (int board = 0; board < size; board++) {
+    features.holes[board] = 0;
+    features.rowTransitions[board] = 0;
+    features.columnTransitions[board] = 0;
+  }
+
+  for (int row = 0; row < GRID_HEIGHT; row++) {
+    const uint16_t *masks = batch.rows[row];
+    const uint16_t *below = row + 1 < GRID_HEIGHT ? batch.rows[row + 1] : floor;
+    int16_t height = GRID_HEIGHT - row;
+
+    for (int board = 0; board < size; board++) {
+      uint16_t mask = masks[board];
+      uint16_t field = mask & ROW_FIELD;
+      uint16_t inStack = (field | covered[board]) != 0; // Rows above the stack don't count
+
+      features.holes[board] += countBits16(~field & covered[board] & ROW_FIELD);
+      features.rowTransitions[board] +=
+          countBits16((mask ^ (mask >> 1)) & ROW_TRANSITION_PAIRS) * inStack;
+      features.columnTransitions[board] += countBits16((mask ^ below[board]) & ROW_FIELD);
+
+      // The first square of a column sets its height, the height of the other columns stays 0
+      uint16_t tops = field & ~covered[board];
+      for (int col = 0; col < GRID_WIDTH; col++) {
+        features.heights[col][board] += ((tops >> (12 - col)) & 1) * height;
+      }
+      covered[board] |= field;
+    }
+  }
+
+  for (int board = 0; board < size; board++) {
+    features.aggregateHeight[board] = 0;
+    features.bumpiness[board] = 0;
+    features.wells[board] = 0;
+  }
+
+  for (int col = 0; col < GRID_WIDTH; col++) {
+    const int16_t *heights = features.heights[col];
+    const int16_t *left = col > 0 ? features.heights[col - 1] : wallHeight;
+    const int16_t *right = col + 1 < GRID_WIDTH ? features.heights[col + 1] : wallHeight;
+    int16_t countBumps = col + 1 < GRID_WIDTH; // There is no bump against the right wall
+
+    for (int board = 0; board < size; board++) {
+      int16_t difference = heights[board] - right[board];
+      int16_t lowest = left[board] < right[board] ? left[board] : right[board];
+      int16_t depth = lowest - heights[board];
+
+      features.aggregateHeight[board] += heights[board];
+      features.bumpiness[board] += (difference < 0 ? -difference : difference) * countBumps;
+      features.wells[board] += depth > 0 ? depth : 0;
+    }
+  }
+}
+
+void evaluateBatch(const BoardBatch &batch, const EvaluatorWeights &weights, float *scores) {
+  BatchFeatures features;
+  computeBatchFeatures(batch, features);
+
+  for (int board = 0; board < batch.count; board++) {
+    scores[board] = weights.aggregateHeight * features.aggregateHeight[board] +
+                    weights.holes * features.holes[board] +
+                    weights.bumpiness * features.bumpiness[board] +
+                    weights.wells * features.wells[board] +
+                    weights.rowTransitions * features.rowTransitions[board] +
+                    weights.columnTransitions * features.columnTransitions[board] +
+                    weights.lineClears[batch.linesCleared[board]];
+  }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "mino_grid.h"
+#include <string>
+
+// Numbers that describe how good (or bad) a stack is. They are all computed from the row masks.
+struct BoardFeatures {
+  int aggregateHeight = 0; // Sum of the height of every column
+  int holes = 0;           // Empty squares with something above them
+  int bumpiness = 0;       // Sum of the height differences between neighbouring columns
+  int wells = 0;           // Sum of the depths of the columns lower than both neighbours
+  int rowTransitions = 0;  // Filled / empty changes along the rows of the stack, walls included
+  int columnTransitions = 0; // Filled / empty changes down the columns, the floor included
+};
+
+// How much each feature counts. Positive values are good, negative ones bad. lineClears is the
+// reward for clearing 0, 1, 2, 3 or 4 lines at once.
+struct EvaluatorWeights {
+  float aggregateHeight = -0.5f;
+  float holes = -4.0f;
+  float bumpiness = -0.3f;
+  float wells = -0.4f;
+  float rowTransitions = -0.4f;
+  float columnTransitions = -0.2f;
+  float lineClears[5] = {0.0f, -1.0f, 0.0f, 1.0f, 6.0f};
+};
+
+// The weights one by one, so they can be saved or tuned without naming each of them: the features
+// in the order above, then lineClears[0] to lineClears[4].
+#define EVALUATOR_WEIGHT_COUNT 11
+
+float &getWeight(EvaluatorWeights &weights, int index);
+const char *getWeightName(int index);
+
+// Weights are saved as text, a "name value" line each. Weights missing from the file keep the
+// value they had. Both return false if the file can't be opened (or has unknown names).
+bool loadEvaluatorWeights(const std::string &path, EvaluatorWeights &weights);
+bool saveEvaluatorWeights(const std::string &path, const EvaluatorWeights &weights);
+
+BoardFeatures computeFeatures(const MinoGrid &grid);
+
+// Higher is better. linesCleared are the lines cleared by the piece that made this board.
+float evaluateBoard(const MinoGrid &grid, int linesCleared, const EvaluatorWeights &weights);
+
+// Boards evaluated together. Search based players score hundreds of boards for every move, so
+// instead of going through them one by one they are packed BOARD_BATCH_SIZE at a time and all the
+// features are computed side by side. The rows are stored row by row across the boards (row 0 of
+// every board, then row 1...), so each step of the kernels does the same thing to a whole row of
+// consecutive values, which the compiler turns into SIMD instructions.
+#define BOARD_BATCH_SIZE 64
+
+struct BoardBatch {
+  uint16_t rows[GRID_HEIGHT][BOARD_BATCH_SIZE] = {};
+  uint8_t linesCleared[BOARD_BATCH_SIZE] = {};
+  int count = 0;
+
+  void clear() { count = 0; }
+  bool isFull() const { return count == BOARD_BATCH_SIZE; }
+  // Adds a board to the batch and returns its index in it
+  int add(const MinoGrid &grid, int linesCleared);
+};
+
+// The features of every board of a batch, as arrays (see BoardFeatures)
+struct BatchFeatures {
+  int16_t heights[GRID_WIDTH][BOARD_BATCH_SIZE];
+  int16_t aggregateHeight[BOARD_BATCH_SIZE];
+  int16_t holes[BOARD_BATCH_SIZE];
+  int16_t bumpiness[BOARD_BATCH_SIZE];
+  int16_t wells[BOARD_BATCH_SIZE];
+  int16_t rowTransitions[BOARD_BATCH_SIZE];
+  int16_t columnTransitions[BOARD_BATCH_SIZE];
+};
+
+// Computes the features of all the boards in the batch. The result is the same as calling
+// computeFeatures for each one (boards past batch.count are left with garbage).
+void computeBatchFeatures(const BoardBatch &batch, BatchFeatures &features);
+
+// Scores all the boards in the batch, like evaluateBoard. scores needs room for batch.count values.
+void evaluateBatch(const BoardBatch &batch, const EvaluatorWeights &weights, float *scores);
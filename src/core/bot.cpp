@@ -0,0 +1,192 @@
+#include "bot.h"
+#include "tetrimino_bag.h"
+#include <algorithm>
+#include <chrono>
+
+Bot::Bot(const BotConfig &config) : config(config) {
+  beam.reserve(config.beamWidth);
+  candidates.reserve(MOVE_MAX_NODES);
+}
+
+// Adds a candidate for every placement of the piece on the parent board (the game board when there
+// is no parent)
+void Bot::addCandidates(const BeamNode *parent, const Tetrimino &piece) {
+  for (const Placement &placement : generator) {
+    Tetrimino placed(piece.getShape());
+    placed.setRotation(placement.rotation);
+    placed.setCol(placement.col);
+    placed.setRow(placement.row);
+
+    candidates.push_back(*parent);
+    BeamNode &candidate = candidates.back();
+
+    candidate.grid.addTetrimino(placed);
+    int lines = candidate.grid.removeCompletedRows();
+
+    candidate.reward += config.weights.lineClears[lines];
+
+    if (parent->rotation < 0) {
+      candidate.rotation = placement.rotation;
+      candidate.col = placement.col;
+      candidate.row = placement.row;
+    }
+  }
+}
+
+// Scores the new boards in batches, which is a lot faster than one by one
+void Bot::scoreCandidates() {
+  float scores[BOARD_BATCH_SIZE];
+
+  for (size_t start = 0; start < candidates.size(); start += BOARD_BATCH_SIZE) {
+    size_t end = std::min(start + BOARD_BATCH_SIZE, candidates.size());
+
+    batch.clear();
+    for (size_t i = start; i < end; i++) {
+      batch.add(candidates[i].grid, 0);
+    }
+
+    evaluateBatch(batch, config.weights, scores);
+
+    for (size_t i = start; i < end; i++) {
+      candidates[i].score = candidates[i].reward + scores[i - start];
+    }
+  }
+}
+
+void Bot::keepBest() {
+  scoreCandidates();
+
+  size_t count = std::min(candidates.size(), (size_t)config.beamWidth);
+
+  std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                    [](const BeamNode &a, const BeamNode &b) { return a.score > b.score; });
+
+  beam.assign(candidates.begin(), candidates.begin() + count);
+  candidates.clear();
+}
+
+bool Bot::plan(const Game &game) {
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + std::chrono::microseconds(config.timeBudgetMicros);
+
+  // A copy of the bag, so looking at the preview doesn't change the game
+  TetriminoBag bag = game.getTetriminoBag();
+  TETRIMINO_SHAPE upcoming[BAG_QUEUE_SIZE];
+  int upcomingCount = bag.preview(upcoming, config.previewPieces);
+
+  BeamNode root = {game.getGrid(), 0.0f, 0.0f, -1, 0, 0};
+
+  candidates.clear();
+  generator.generate(root.grid, game.getCurrentTetrimino());
+  addCandidates(&root, game.getCurrentTetrimino());
+
+  if (candidates.empty()) {
+    return false;
+  }
+  keepBest();
+
+  for (int i = 0; i < upcomingCount; i++) {
+    if (config.timeBudgetMicros > 0 && std::chrono::steady_clock::now() >= deadline) {
+      break;
+    }
+
+    Tetrimino piece(upcoming[i]);
+
+    for (const BeamNode &node : beam) {
+      if (generator.generate(node.grid, piece) > 0) {
+        addCandidates(&node, piece);
+      }
+    }
+
+    // All the boards top out with this piece, the best one we have is as good as it gets
+    if (candidates.empty()) {
+      break;
+    }
+    keepBest();
+  }
+
+  const RotationData &data = PIECE_TABLE.rotations[game.getCurrentTetrimino().getShape()]
+                                                  [beam[0].rotation];
+  targetRotation = data.sameAs;
+  targetCol = beam[0].col + data.sameAsX;
+  targetRow = beam[0].row + data.sameAsY;
+
+  searchMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                     std::chrono::steady_clock::now() - start)
+                     .count();
+  return true;
+}
+
+// Index of the target in the placements the generator found last, -1 if it's not there
+int Bot::findTarget() const {
+  for (int i = 0; i < generator.getPlacementCount(); i++) {
+    const Placement &placement = generator.getPlacement(i);
+    const RotationData &data = PIECE_TABLE.rotations[generator.getShape()][placement.rotation];
+
+    if (data.sameAs == targetRotation && placement.col + data.sameAsX == targetCol &&
+        placement.row + data.sameAsY == targetRow) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool Bot::getTarget(int &rotation, int &col, int &row) const {
+  rotation = targetRotation;
+  col = targetCol;
+  row = targetRow;
+  return hasTarget;
+}
+
+uint8_t Bot::nextInputs(const Game &game) {
+  if (game.isToppedOut() || game.isClearingLines()) {
+    lastInputs = 0;
+    return 0;
+  }
+
+  if (game.getPieceCount() != plannedPiece) {
+    plannedPiece = game.getPieceCount();
+    hasTarget = plan(game);
+    presses = 0;
+  }
+
+  // The piece keeps falling while we move it, so the way to the target is searched again on every
+  // tick. If gravity took it past the point where the target could be reached, pick another one.
+  generator.generate(game.getGrid(), game.getCurrentTetrimino());
+  int target = hasTarget ? findTarget() : -1;
+
+  if (target < 0 && hasTarget) {
+    hasTarget = plan(game);
+
+    // The search leaves the generator on whatever board and piece it looked at last
+    generator.generate(game.getGrid(), game.getCurrentTetrimino());
+    target = hasTarget ? findTarget() : -1;
+  }
+
+  uint8_t button = INPUT_HARD_DROP;
+
+  if (target >= 0 && presses < BOT_MAX_PRESSES) {
+    PIECE_MOVE moves[MOVE_MAX_NODES];
+    int count = generator.getPath(generator.getPlacement(target), moves, MOVE_MAX_NODES);
+
+    // Straight down from here, hard drop. Otherwise do the first move that isn't down, unless the
+    // piece has to go down first to get under something.
+    for (int i = 0; i < count; i++) {
+      if (moves[i] != MOVE_DOWN) {
+        const uint8_t buttons[] = {INPUT_LEFT, INPUT_RIGHT, INPUT_DOWN, INPUT_ROTATE};
+        button = buttons[moves[0]];
+        break;
+      }
+    }
+  }
+
+  // The game only acts when a button goes down, so the same button has to be released in between
+  if (lastInputs & button) {
+    lastInputs = 0;
+    return 0;
+  }
+
+  presses++;
+  lastInputs = button;
+  return button;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "board_evaluator.h"
+#include "game.h"
+#include "input_source.h"
+#include "move_generator.h"
+#include <cstdint>
+#include <vector>
+
+// Button presses the bot can spend on a single piece. Gravity can move the piece while the bot is
+// turning it near the stack, and with wall kicks it may go around in circles forever (every move
+// resets the lock delay). After this many presses it just drops the piece where it is.
+#define BOT_MAX_PRESSES 40
+
+struct BotConfig {
+  int previewPieces = 2; // Pieces from the preview searched after the current one
+  int beamWidth = 8;     // Best boards kept after each piece
+  // Longest a search can take, the best move so far is used after it. With 0 there is no limit,
+  // which is the only way to get the same moves on every run (and every machine).
+  int timeBudgetMicros = 5000;
+  EvaluatorWeights weights;
+};
+
+// Plays the game in place of the keyboard. When a new piece comes in, it searches the placements
+// of that piece and the next ones from the preview (a beam search: only the best few boards after
+// each piece are searched further) and picks the one that leads to the best board. Then, on every
+// tick, it presses whatever button gets the piece closer to it.
+class Bot : public InputSource {
+private:
+  struct BeamNode {
+    MinoGrid grid;
+    float reward; // Line clears along the way
+    float score;  // reward plus how good the board looks
+    int8_t rotation, col, row; // Where the current piece goes to end up here
+  };
+
+  BotConfig config;
+  MoveGenerator generator;
+  std::vector<BeamNode> beam;
+  std::vector<BeamNode> candidates;
+  BoardBatch batch;
+
+  long plannedPiece = -1; // Piece count the target was picked for
+  bool hasTarget = false;
+  int targetRotation = 0; // The first rotation with the same squares, see RotationData::sameAs
+  int targetCol = 0;
+  int targetRow = 0;
+
+  uint8_t lastInputs = 0;
+  int presses = 0; // Buttons pressed for the current piece
+  long searchMicros = 0;
+
+  void addCandidates(const BeamNode *parent, const Tetrimino &piece);
+  void scoreCandidates();
+  void keepBest();
+  bool plan(const Game &game);
+  int findTarget() const;
+
+public:
+  explicit Bot(const BotConfig &config = BotConfig());
+
+  uint8_t nextInputs(const Game &game) override;
+
+  const BotConfig &getConfig() const { return config; }
+  long getSearchMicros() const { return searchMicros; } // How long the last search took
+
+  // Where the bot is taking the current piece, false if it has nowhere to go. The rotation is the
+  // first one with the same squares (see RotationData::sameAs).
+  bool getTarget(int &rotation, int &col, int &row) const;
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Little helpers to write and read compact binary data (replays, saved game states). Numbers are
+// always stored little-endian, so files can be shared between machines.
+class ByteWriter {
+private:
+  std::vector<uint8_t> data;
+
+public:
+  ByteWriter() = default;
+  explicit ByteWriter(size_t capacity) { data.reserve(capacity); }
+
+  void putU8(uint8_t value) { data.push_back(value); }
+  void putU16(uint16_t value) {
+    putU8(value & 0xFF);
+    putU8(value >> 8);
+  }
+  void putU32(uint32_t value) {
+    putU16(value & 0xFFFF);
+    putU16(value >> 16);
+  }
+  void putU64(uint64_t value) {
+    putU32(value & 0xFFFFFFFF);
+    putU32(value >> 32);
+  }
+
+  // Variable length unsigned number: 7 bits per byte, the high bit says if more bytes follow
+  void putVarint(uint64_t value) {
+    while (value >= 0x80) {
+      putU8((value & 0x7F) | 0x80);
+      value >>= 7;
+    }
+    putU8(value);
+  }
+
+  // Signed numbers are zigzag encoded first, so small negative numbers stay small
+  void putSignedVarint(int64_t value) {
+    putVarint(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+  }
+
+  void putBytes(const uint8_t *bytes, size_t count) {
+    data.insert(data.end(), bytes, bytes + count);
+  }
+
+  const uint8_t *bytes() const { return data.data(); }
+  size_t size() const { return data.size(); }
+  size_t capacity() const { return data.capacity(); }
+  void clear() { data.clear(); }
+};
+
+// Reads what a ByteWriter wrote. Reading past the end doesn't crash, it returns zeros and marks the
+// reader as failed, so callers can check once at the end.
+class ByteReader {
+private:
+  const uint8_t *cursor;
+  const uint8_t *end;
+  bool failed = false;
+
+public:
+  ByteReader(const uint8_t *data, size_t size) : cursor(data), end(data + size) {}
+
+  uint8_t getU8() {
+    if (cursor >= end) {
+      failed = true;
+      return 0;
+    }
+    return *cursor++;
+  }
+  uint16_t getU16() {
+    uint16_t low = getU8();
+    return low | (uint16_t)getU8() << 8;
+  }
+  uint32_t getU32() {
+    uint32_t low = getU16();
+    return low | (uint32_t)getU16() << 16;
+  }
+  uint64_t getU64() {
+    uint64_t low = getU32();
+    return low | (uint64_t)getU32() << 32;
+  }
+
+  uint64_t getVarint() {
+    uint64_t value = 0;
+
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte = getU8();
+      value |= (uint64_t)(byte & 0x7F) << shift;
+
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+
+    failed = true;
+    return value;
+  }
+
+  int64_t getSignedVarint() {
+    uint64_t value = getVarint();
+    return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+  }
+
+  const uint8_t *position() const { return cursor; }
+  size_t remaining() const { return end - cursor; }
+  void skip(size_t count) {
+    if (count > remaining()) {
+      failed = true;
+      count = remaining();
+    }
+    cursor += count;
+  }
+  bool hasFailed() const { return failed; }
+};
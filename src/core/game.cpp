@@ -0,0 +1,401 @@
+#include "game.h"
+#include "move_generator.h"
+#include <algorithm>
+#include <cmath>
+
+const float LOCK_DELAY = 0.5f;        // Time before a tetrimino locks in place
+const float KEY_REPEAT_DELAY = 0.15f; // Initial delay before repeating
+const float KEY_REPEAT_RATE = 0.05f;  // Time between repeats
+const float LINE_CLEAR_DELAY = 0.3f;  // How long the game is paused while lines are cleared
+
+// Official Tetris speed curve (frames at 60 FPS)
+// Level 1: 48 frames = 0.8 seconds
+// Level 2: 43 frames = ~0.72 seconds
+// etc.
+const float FALL_SPEEDS[MAX_SPEED_LEVEL] = {
+    0.8f,  // Level 1
+    0.72f, // Level 2
+    0.63f, // Level 3
+    0.55f, // Level 4
+    0.47f, // Level 5
+    0.38f, // Level 6
+    0.30f, // Level 7
+    0.22f, // Level 8
+    0.13f, // Level 9
+    0.10f, // Level 10
+    0.08f, // Level 11
+    0.07f, // Level 12
+    0.05f, // Level 13
+    0.04f, // Level 14
+    0.03f, // Level 15
+    0.02f  // Level 16+
+};
+
+Game::Game(uint64_t seed, int tickRate) : tetriminoBag(seed), tickRate(tickRate) {
+  lockDelay = secondsToTicks(LOCK_DELAY);
+  keyRepeatDelay = secondsToTicks(KEY_REPEAT_DELAY);
+  keyRepeatRate = secondsToTicks(KEY_REPEAT_RATE);
+  lineClearDelay = secondsToTicks(LINE_CLEAR_DELAY);
+
+  for (int level = 0; level < MAX_SPEED_LEVEL; level++) {
+    fallSpeeds[level] = secondsToTicks(FALL_SPEEDS[level]);
+  }
+
+  spawnTetrimino();
+}
+
+// Rounds a duration to the nearest number of ticks, but never less than one
+int Game::secondsToTicks(float seconds) const {
+  return std::max(1, (int)std::lround(seconds * tickRate));
+}
+
+Tetrimino Game::getGhostPiece() const {
+  Tetrimino ghost = currentTetrimino;
+  ghost.setRow(ghost.getRow() + grid.getDropDistance(ghost));
+  return ghost;
+}
+
+// Ticks between each row the tetrimino falls in the current level
+int Game::getFallSpeed() const {
+  int levelIndex = std::min(currentLevel - 1, MAX_SPEED_LEVEL - 1); // Cap at level 16
+  return fallSpeeds[levelIndex];
+}
+
+void Game::spawnTetrimino() {
+  currentTetrimino = Tetrimino(tetriminoBag.getNextShape());
+  pieceCount++;
+
+  // No room for the new tetrimino, the stack reached the top
+  if (grid.TetriminoOverlapping(currentTetrimino)) {
+    toppedOut = true;
+    events |= EVENT_TOP_OUT;
+  }
+}
+
+void Game::RotateCurrentTetrimino(ROTATE_DIRECTION direction) {
+  int rotation = currentTetrimino.getRotationIndex();
+  int col = currentTetrimino.getCol();
+  int row = currentTetrimino.getRow();
+
+  // If the tetrimino can't rotate, not even with a wall kick, it just stays as it was
+  if (grid.rotatePiece(currentTetrimino.getShape(), rotation, col, row, direction)) {
+    currentTetrimino.setRotation(rotation);
+    currentTetrimino.setCol(col);
+    currentTetrimino.setRow(row);
+  }
+}
+
+uint32_t Game::step(uint8_t inputs) {
+  events = 0;
+
+  if (toppedOut) {
+    return events;
+  }
+
+  tickCount++;
+
+  // Pause game logic during line clears. Once they are done the rows are removed and the next
+  // tetrimino comes in.
+  if (isClearingLines()) {
+    lineClearTimer++;
+
+    if (lineClearTimer < lineClearDelay) {
+      previousInputs = inputs;
+      return events;
+    }
+
+    grid.removeCompletedRows();
+    clearingRows.clear();
+    spawnTetrimino();
+
+    if (toppedOut) {
+      return events;
+    }
+  }
+
+  int currentFallSpeed = getFallSpeed();
+  fallTimer++;
+
+  // Check if the current tetrimino should fall 1 row down
+  if (fallTimer >= currentFallSpeed && !currentTetrimino.isLocked()) {
+    if (!grid.isTouchingDown(currentTetrimino)) {
+      currentTetrimino.moveDown();
+      currentTetrimino.resetLockTimer(); // Reset lock timer
+    } else {
+      if (!currentTetrimino.isLocking()) {
+        // Just landed
+        currentTetrimino.resetLockTimer(); // Reset lock timer
+      }
+    }
+    fallTimer = 0; // Reset fall timer
+  }
+
+  // Handle lock delay
+  if (grid.isTouchingDown(currentTetrimino) && !currentTetrimino.isLocked()) {
+    currentTetrimino.addToLockTimer();
+
+    if (currentTetrimino.getLockTimer() >= lockDelay) {
+      currentTetrimino.lock();
+      events |= EVENT_LOCK;
+    }
+  }
+
+  // Add the tetrimino to the grid and generate a new one (or start clearing lines)
+  if (currentTetrimino.isLocked()) {
+    lockCurrentTetrimino();
+    previousInputs = inputs;
+    return events;
+  }
+
+  handleInput(inputs);
+  previousInputs = inputs;
+
+  return events;
+}
+
+void Game::lockCurrentTetrimino() {
+  grid.addTetrimino(currentTetrimino); // Add the tetrimino to the grid
+
+  // Check for completed lines. If there are any the next tetrimino only comes in after they
+  // are cleared.
+  clearingRows = grid.getCompletedRows(currentTetrimino);
+
+  if (!clearingRows.empty()) {
+    lineClearTimer = 0;
+    events |= EVENT_LINE_CLEAR;
+    handleLineClears(clearingRows.size());
+    return;
+  }
+
+  spawnTetrimino();
+}
+
+void Game::handleInput(uint8_t inputs) {
+  /********************************************
+   * ROTATE (CLOCKWISE)
+   ********************************************/
+  if (isPressed(inputs, INPUT_ROTATE) && !currentTetrimino.isLocked()) {
+    RotateCurrentTetrimino(ROTATE_DIRECTION::RIGHT);
+    currentTetrimino.resetLockTimer(); // Reset lock timer
+    events |= EVENT_ROTATE;
+  }
+
+  /********************************************
+   * HARD DROP
+   ********************************************/
+  if (isPressed(inputs, INPUT_HARD_DROP) && !currentTetrimino.isLocked()) {
+    // TODO: this is to be used for points
+    int dropDistance = grid.getDropDistance(currentTetrimino);
+    currentTetrimino.setRow(currentTetrimino.getRow() + dropDistance);
+
+    currentTetrimino.lock();
+    events |= EVENT_HARD_DROP;
+  }
+
+  /********************************************
+   * RIGHT
+   ********************************************/
+  if ((inputs & INPUT_RIGHT) && !currentTetrimino.isLocked()) {
+    if (isPressed(inputs, INPUT_RIGHT)) {
+      // First press, move immediately
+      if (!grid.isTouchingRight(currentTetrimino)) {
+        currentTetrimino.resetLockTimer(); // Reset lock timer
+        currentTetrimino.moveRight();
+        events |= EVENT_MOVE;
+      }
+      rightKeyTimer = keyRepeatDelay; // Set initial delay
+    } else {
+      // Key held down - check timer
+      rightKeyTimer--;
+      if (rightKeyTimer <= 0) {
+        if (!grid.isTouchingRight(currentTetrimino)) {
+          currentTetrimino.resetLockTimer(); // Reset lock timer
+          currentTetrimino.moveRight();
+          events |= EVENT_MOVE;
+        }
+        rightKeyTimer = keyRepeatRate; // Set repeat rate
+      }
+    }
+  } else {
+    rightKeyTimer = 0; // Reset timer when key released
+  }
+
+  /********************************************
+   * LEFT
+   ********************************************/
+  if ((inputs & INPUT_LEFT) && !currentTetrimino.isLocked()) {
+    if (isPressed(inputs, INPUT_LEFT)) {
+      // First press, move immediately
+      if (!grid.isTouchingLeft(currentTetrimino)) {
+        currentTetrimino.resetLockTimer(); // Reset lock timer
+        currentTetrimino.moveLeft();
+        events |= EVENT_MOVE;
+      }
+      leftKeyTimer = keyRepeatDelay; // Set initial delay
+    } else {
+      // Key held down - check timer
+      leftKeyTimer--;
+      if (leftKeyTimer <= 0) {
+        if (!grid.isTouchingLeft(currentTetrimino)) {
+          currentTetrimino.resetLockTimer(); // Reset lock timer
+          currentTetrimino.moveLeft();
+          events |= EVENT_MOVE;
+        }
+        leftKeyTimer = keyRepeatRate; // Set repeat rate
+      }
+    }
+  } else {
+    leftKeyTimer = 0; // Reset timer when key released
+  }
+
+  /********************************************
+   * DOWN (SOFT DROP)
+   ********************************************/
+  if ((inputs & INPUT_DOWN) && !currentTetrimino.isLocked()) {
+    if (isPressed(inputs, INPUT_DOWN)) {
+      if (!grid.isTouchingDown(currentTetrimino)) {
+        currentTetrimino.moveDown();
+        events |= EVENT_MOVE;
+      }
+      downKeyTimer = keyRepeatDelay; // Set initial delay
+    } else {
+      // Key held down - check timer
+      downKeyTimer--;
+      if (downKeyTimer <= 0) {
+        if (!grid.isTouchingDown(currentTetrimino)) {
+          currentTetrimino.moveDown();
+        }
+        downKeyTimer = keyRepeatRate; // Set repeat rate
+      }
+    }
+  } else {
+    downKeyTimer = 0; // Reset timer when key released
+  }
+}
+
+void Game::handleLineClears(int linesCleared) {
+  if (linesCleared <= 0)
+    return;
+
+  // Update total lines cleared
+  totalLinesCleared += linesCleared;
+
+  // Update score based on the number of lines cleared
+  updateScore(linesCleared);
+
+  // Check if we need to increase the level (typically every 10 lines)
+  updateLevel();
+}
+
+void Game::updateScore(int linesCleared) {
+  int basePoints = 0;
+
+  switch (linesCleared) {
+  case 1:
+    basePoints = SINGLE_LINE_SCORE; // 40 points for a single line clear
+    break;
+  case 2:
+    basePoints = DOUBLE_LINE_SCORE; // 100 points for a double line clear
+    break;
+  case 3:
+    basePoints = TRIPLE_LINE_SCORE; // 300 points for a triple line clear
+    break;
+  case 4:
+    basePoints = TETRIS_LINE_SCORE; // 1200 points for a Tetris (four lines clear)
+    break;
+  default:
+    return; // No points for invalid line clears
+  }
+
+  // Score is multiplied by the current level (official Tetris scoring)
+  currentScore += basePoints * currentLevel;
+}
+
+void Game::updateLevel() {
+  // Standard rule: level increases every 10 lines cleared
+  int newLevel = (totalLinesCleared / 10) + 1;
+
+  if (newLevel > currentLevel) {
+    currentLevel = newLevel;
+    events |= EVENT_LEVEL_UP;
+  }
+}
+
+void Game::saveState(ByteWriter &writer) const {
+  grid.saveState(writer);
+  currentTetrimino.saveState(writer);
+  tetriminoBag.saveState(writer);
+
+  writer.putVarint(currentLevel);
+  writer.putVarint(currentScore);
+  writer.putVarint(totalLinesCleared);
+  writer.putVarint(fallTimer);
+  writer.putVarint(leftKeyTimer);
+  writer.putVarint(rightKeyTimer);
+  writer.putVarint(downKeyTimer);
+
+  writer.putU8(clearingRows.size());
+  for (int row : clearingRows) {
+    writer.putU8(row);
+  }
+  writer.putVarint(lineClearTimer);
+
+  writer.putVarint(tickCount);
+  writer.putVarint(pieceCount);
+  writer.putU8(previousInputs);
+  writer.putU8(toppedOut);
+}
+
+bool Game::loadState(ByteReader &reader) {
+  if (!grid.loadState(reader) || !currentTetrimino.loadState(reader) ||
+      !tetriminoBag.loadState(reader)) {
+    return false;
+  }
+
+  currentLevel = reader.getVarint();
+  if (currentLevel < 1) {
+    return false;
+  }
+
+  currentScore = reader.getVarint();
+  totalLinesCleared = reader.getVarint();
+  fallTimer = reader.getVarint();
+  leftKeyTimer = reader.getVarint();
+  rightKeyTimer = reader.getVarint();
+  downKeyTimer = reader.getVarint();
+
+  int clearingCount = reader.getU8();
+  if (clearingCount > (int)GRID_HEIGHT) {
+    return false;
+  }
+
+  clearingRows.clear();
+  for (int i = 0; i < clearingCount; i++) {
+    int row = reader.getU8();
+    if (row >= (int)GRID_HEIGHT) {
+      return false;
+    }
+    clearingRows.add(row);
+  }
+  lineClearTimer = reader.getVarint();
+
+  tickCount = reader.getVarint();
+  pieceCount = reader.getVarint();
+  previousInputs = reader.getU8();
+  toppedOut = reader.getU8();
+  events = 0;
+
+  // The tetrimino has to be somewhere it could have got to. While lines are being cleared it is
+  // already part of the grid, and the one that topped out the game overlaps the stack.
+  int col = currentTetrimino.getCol();
+  int row = currentTetrimino.getRow();
+  if (col < -GRID_WALL_WIDTH || col >= (int)GRID_WIDTH || row < MOVE_TOP_ROW ||
+      row >= (int)GRID_HEIGHT) {
+    return false;
+  }
+  if (!isClearingLines() && !toppedOut && grid.TetriminoOverlapping(currentTetrimino)) {
+    return false;
+  }
+
+  return !reader.hasFailed();
+}
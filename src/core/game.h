@@ -0,0 +1,121 @@
+#pragma once
+
+#include "byte_stream.h"
+#include "mino_grid.h"
+#include "tetrimino.h"
+#include "tetrimino_bag.h"
+#include <cstdint>
+#include <vector>
+
+// The game advances in fixed steps (ticks). This is how many there are per second unless the game
+// is created with a different rate. All the timings are converted to a whole number of ticks.
+#define DEFAULT_TICK_RATE 60
+
+// Buttons held down during a step. The game compares them with the ones from the previous step to
+// know when a button was just pressed.
+#define INPUT_LEFT 0x01u
+#define INPUT_RIGHT 0x02u
+#define INPUT_DOWN 0x04u
+#define INPUT_ROTATE 0x08u
+#define INPUT_HARD_DROP 0x10u
+
+// Things that happened during a step. This is what the frontend uses to play sounds.
+#define EVENT_MOVE 0x01u
+#define EVENT_ROTATE 0x02u
+#define EVENT_LOCK 0x04u
+#define EVENT_HARD_DROP 0x08u
+#define EVENT_LINE_CLEAR 0x10u
+#define EVENT_LEVEL_UP 0x20u
+#define EVENT_TOP_OUT 0x40u
+
+// Levels with their own fall speed, the ones after the last are as fast as it
+#define MAX_SPEED_LEVEL 16
+
+// The rules of the game: gravity, lock delay, line clears, scoring and levels. It doesn't know
+// anything about windows, textures or sounds, it just advances one step at a time with whatever
+// buttons are being held down, so it can run headless as fast as the CPU allows.
+class Game {
+private:
+  MinoGrid grid;
+  Tetrimino currentTetrimino;
+  TetriminoBag tetriminoBag;
+
+  int currentLevel = 1;      // Current level
+  long currentScore = 0;     // Current score
+  int totalLinesCleared = 0; // Total lines cleared
+
+  // Timings in ticks, calculated from the tick rate
+  int tickRate;
+  int lockDelay;      // Ticks before a tetrimino locks in place
+  int keyRepeatDelay; // Initial delay before repeating
+  int keyRepeatRate;  // Ticks between repeats
+  int lineClearDelay; // How long the game is paused while lines are cleared
+  int fallSpeeds[MAX_SPEED_LEVEL]; // Ticks between each row a tetrimino falls, for each level
+
+  // Tick counters
+  int fallTimer = 0;
+  int leftKeyTimer = 0;
+  int rightKeyTimer = 0;
+  int downKeyTimer = 0;
+
+  // Rows waiting to be removed. The game logic is paused while they are being cleared.
+  RowList clearingRows;
+  int lineClearTimer = 0;
+
+  long tickCount = 0;  // Ticks since the start of the game
+  long pieceCount = 0; // Tetriminos spawned since the start of the game
+
+  uint8_t previousInputs = 0; // Buttons held down in the previous step
+  uint32_t events = 0;        // Events of the current step
+  bool toppedOut = false;     // A new tetrimino couldn't be placed, the game is over
+
+  // Line clear scoring (official Tetris scoring)
+  static const int SINGLE_LINE_SCORE = 40;
+  static const int DOUBLE_LINE_SCORE = 100;
+  static const int TRIPLE_LINE_SCORE = 300;
+  static const int TETRIS_LINE_SCORE = 1200;
+
+  bool isPressed(uint8_t inputs, uint8_t button) const {
+    return (inputs & button) && !(previousInputs & button);
+  }
+  void RotateCurrentTetrimino(ROTATE_DIRECTION direction);
+  void handleInput(uint8_t inputs);
+  int secondsToTicks(float seconds) const;
+  void handleLineClears(int linesCleared);
+  void updateScore(int linesCleared);
+  void updateLevel();
+  void lockCurrentTetrimino();
+  void spawnTetrimino();
+
+public:
+  explicit Game(uint64_t seed, int tickRate = DEFAULT_TICK_RATE);
+
+  // Advances the game by one tick (1 / tickRate seconds) with the given INPUT_* buttons held down.
+  // Returns the EVENT_* flags for everything that happened during the tick.
+  uint32_t step(uint8_t inputs);
+
+  const MinoGrid &getGrid() const { return grid; }
+  const Tetrimino &getCurrentTetrimino() const { return currentTetrimino; }
+  // The current tetrimino moved straight down as far as it goes, where a hard drop would put it
+  Tetrimino getGhostPiece() const;
+  TetriminoBag &getTetriminoBag() { return tetriminoBag; }
+  const TetriminoBag &getTetriminoBag() const { return tetriminoBag; }
+  int getLevel() const { return currentLevel; }
+  long getScore() const { return currentScore; }
+  int getLinesCleared() const { return totalLinesCleared; }
+  int getFallSpeed() const;
+  int getFallTimer() const { return fallTimer; }
+  bool isClearingLines() const { return !clearingRows.empty(); }
+  const RowList &getClearingRows() const { return clearingRows; }
+  int getLineClearTimer() const { return lineClearTimer; }
+  bool isToppedOut() const { return toppedOut; }
+  int getTickRate() const { return tickRate; }
+  long getTickCount() const { return tickCount; }
+  long getPieceCount() const { return pieceCount; }
+  float ticksToSeconds(int ticks) const { return (float)ticks / tickRate; }
+
+  // Writes everything needed to continue the game from this exact tick, in a compact form. The
+  // tick rate is not included, the state has to be loaded into a game created with the same rate.
+  void saveState(ByteWriter &writer) const;
+  bool loadState(ByteReader &reader);
+};
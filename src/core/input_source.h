@@ -0,0 +1,14 @@
+#pragma once
+
+#include "game.h"
+#include <cstdint>
+
+// Something that decides which buttons are held down on each tick: the keyboard, a replay or a
+// bot. Whatever it is, the game receives the inputs through Game::step like any other.
+class InputSource {
+public:
+  virtual ~InputSource() = default;
+
+  // INPUT_* buttons to hold down for the next tick of the given game
+  virtual uint8_t nextInputs(const Game &game) = 0;
+};
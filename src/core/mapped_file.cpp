@@ -0,0 +1,80 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile() { close(); }
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string &path) {
+  close();
+
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return false;
+  }
+
+  buffer.resize(file.tellg());
+  file.seekg(0);
+
+  if (buffer.empty() || !file.read((char *)buffer.data(), buffer.size())) {
+    buffer.clear();
+    return false;
+  }
+
+  data = buffer.data();
+  size = buffer.size();
+  return true;
+}
+
+void MappedFile::close() {
+  buffer.clear();
+  data = nullptr;
+  size = 0;
+}
+
+#else
+
+bool MappedFile::open(const std::string &path) {
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    ::close(fd);
+    return false;
+  }
+
+  void *mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // The mapping stays valid after the file is closed
+
+  if (mapping == MAP_FAILED) {
+    return false;
+  }
+
+  data = (const uint8_t *)mapping;
+  size = info.st_size;
+  return true;
+}
+
+void MappedFile::close() {
+  if (data) {
+    munmap((void *)data, size);
+  }
+
+  data = nullptr;
+  size = 0;
+}
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A whole file mapped read-only into memory. Opening it doesn't read anything, the pages are loaded
+// by the OS when they are touched, so opening a big file costs the same as opening a small one.
+class MappedFile {
+private:
+  const uint8_t *data = nullptr;
+  size_t size = 0;
+
+#ifdef _WIN32
+  std::vector<uint8_t> buffer; // No mmap here, the file is just read into memory
+#endif
+
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool open(const std::string &path);
+  void close();
+
+  bool isOpen() const { return data != nullptr; }
+  const uint8_t *getData() const { return data; }
+  size_t getSize() const { return size; }
+};
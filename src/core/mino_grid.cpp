@@ -0,0 +1,305 @@
+#include "mino_grid.h"
+#include "tetrimino.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+// Returns the occupancy of the 4 rows starting at the given row, packed in the same way as the
+// RotationData slice. Rows above the playfield only have the walls and rows below it are full.
+uint64_t MinoGrid::rowSlice(int row) const {
+  if (row >= 0 && row <= (int)GRID_HEIGHT) {
+    return (uint64_t)rows[row] | (uint64_t)rows[row + 1] << 16 | (uint64_t)rows[row + 2] << 32 |
+           (uint64_t)rows[row + 3] << 48;
+  }
+
+  uint64_t slice = 0;
+  for (int y = 0; y < NUMBER_OF_ROTATIONS; y++) {
+    int gridY = row + y;
+    uint64_t mask = gridY < 0 ? ROW_EMPTY : gridY < (int)GRID_HEIGHT ? rows[gridY] : ROW_FULL;
+    slice |= mask << (16 * y);
+  }
+  return slice;
+}
+
+bool MinoGrid::collides(const RotationData &rotation, int col, int row) const {
+  // Past these columns none of the tetrimino squares can be inside the playfield anymore
+  if (col < -GRID_WALL_WIDTH || col > (int)GRID_WIDTH - 1) {
+    return true;
+  }
+
+  // Every row of the slice has the tetrimino squares in the lowest 4 bits of its lane, which is
+  // where they need to be for the rightmost column. Shifting it left moves all 4 rows at once.
+  return rowSlice(row) & (rotation.slice << (GRID_WIDTH - 1 - col));
+}
+
+bool MinoGrid::TetriminoOverlapping(const Tetrimino &tetrimino) const {
+  return collides(tetrimino.getRotationData(), tetrimino.getCol(), tetrimino.getRow());
+}
+
+// If the rotated tetrimino would overlap existing minos or end up outside of the playfield then we
+// need to perform a wall kick. Depending on the rotation being executed different coordinates will
+// be tested, the first one where the tetrimino fits is used.
+bool MinoGrid::rotatePiece(TETRIMINO_SHAPE shape, int &rotation, int &col, int &row,
+                           ROTATE_DIRECTION direction) const {
+  int newRotation = (rotation + (direction == RIGHT ? 1 : NUMBER_OF_ROTATIONS - 1)) %
+                    NUMBER_OF_ROTATIONS;
+  const RotationData &data = PIECE_TABLE.rotations[shape][newRotation];
+
+  if (!collides(data, col, row)) {
+    rotation = newRotation;
+    return true;
+  }
+
+  const KickData *kicks = PIECE_TABLE.kicks[shape][rotation][newRotation];
+
+  for (int i = 0; i < NUMBER_OF_ROTATIONS; i++) {
+    int kickCol = col + (*kicks)[i][0];
+    int kickRow = row + (*kicks)[i][1];
+
+    if (!collides(data, kickCol, kickRow)) {
+      rotation = newRotation;
+      col = kickCol;
+      row = kickRow;
+      return true;
+    }
+  }
+
+  // We couldn't wall kick!
+  return false;
+}
+
+// Check if the tetrimino is touching the left margin of the playfield or exiting squares in the
+// grid matrix. If it is, return true.
+bool MinoGrid::isTouchingLeft(const Tetrimino &tetrimino) const {
+  return collides(tetrimino.getRotationData(), tetrimino.getCol() - 1, tetrimino.getRow());
+}
+
+// Check if the tetrimino is touching the right margin of the playfield or exiting squares in the
+// grid matrix. If it is, return true.
+bool MinoGrid::isTouchingRight(const Tetrimino &tetrimino) const {
+  return collides(tetrimino.getRotationData(), tetrimino.getCol() + 1, tetrimino.getRow());
+}
+
+// Check if the tetrimino is touching the bottom margin of the playfield or exiting squares in the
+// grid matrix. If it is, return true.
+bool MinoGrid::isTouchingDown(const Tetrimino &tetrimino) const {
+  return collides(tetrimino.getRotationData(), tetrimino.getCol(), tetrimino.getRow() + 1);
+}
+
+int MinoGrid::getDropDistance(const Tetrimino &tetrimino) const {
+  const RotationData &data = tetrimino.getRotationData();
+  int col = tetrimino.getCol();
+  int row = tetrimino.getRow();
+  int distance = INT_MAX;
+  bool aboveStack = true;
+
+  // Every column of the tetrimino can fall until its lowest square is right above the top of that
+  // column in the grid. The one that gets there first stops the whole tetrimino.
+  for (int x = data.minX; x <= data.maxX; x++) {
+    int gridCol = col + x;
+    int bottom = row + data.bottoms[x];
+
+    if (gridCol < 0 || gridCol >= (int)width || bottom >= columnTops[gridCol]) {
+      aboveStack = false;
+      break;
+    }
+    distance = std::min(distance, columnTops[gridCol] - 1 - bottom);
+  }
+
+  if (aboveStack) {
+    return distance;
+  }
+
+  // Tucked under an overhang (or not in the playfield at all), the skyline doesn't say how far it
+  // can go. Search row by row.
+  distance = 0;
+  while (!collides(data, col, row + distance + 1)) {
+    distance++;
+  }
+  return distance;
+}
+
+void MinoGrid::clear() {
+  for (int y = 0; y < GRID_HEIGHT; y++) {
+    rows[y] = ROW_EMPTY;
+  }
+  for (int y = GRID_HEIGHT; y < GRID_HEIGHT + 4; y++) {
+    rows[y] = ROW_FULL; // The floor
+  }
+  memset(colors, 0, sizeof(colors));
+  memset(columnTops, GRID_HEIGHT, sizeof(columnTops));
+}
+
+void MinoGrid::setCell(int col, int row, int value) {
+  if (value) {
+    rows[row] |= COLUMN_BIT(col);
+    columnTops[col] = std::min<int>(columnTops[col], row);
+  } else {
+    rows[row] &= ~COLUMN_BIT(col);
+    if (row == columnTops[col]) {
+      updateColumnTop(col);
+    }
+  }
+  colors[row][col] = value;
+}
+
+// Looks for the top of the column again, from where it was down
+void MinoGrid::updateColumnTop(int col) {
+  int row = columnTops[col];
+  while (row < (int)height && !(rows[row] & COLUMN_BIT(col))) {
+    row++;
+  }
+  columnTops[col] = row;
+}
+
+// Finds the top of every column, going down the rows until all of them have been found
+void MinoGrid::updateSkyline() {
+  memset(columnTops, GRID_HEIGHT, sizeof(columnTops));
+  uint16_t found = 0;
+
+  for (int row = 0; row < (int)height && found != ROW_FIELD; row++) {
+    uint16_t tops = rows[row] & ROW_FIELD & ~found;
+    found |= tops;
+
+    for (int col = 0; tops && col < (int)GRID_WIDTH; col++) {
+      if (tops & COLUMN_BIT(col)) {
+        columnTops[col] = row;
+        tops &= ~COLUMN_BIT(col);
+      }
+    }
+  }
+}
+
+void MinoGrid::addTetrimino(const Tetrimino &tetrimino) {
+  int tetCol = tetrimino.getCol();
+  int tetRow = tetrimino.getRow();
+
+  for (const MinoOffset &cell : tetrimino.getRotationData().cells) {
+    int gridX = tetCol + cell.x;
+    int gridY = tetRow + cell.y;
+
+    if (gridX >= 0 && gridX < width && gridY >= 0 && gridY < height) {
+      // Add the mino to the matrix. The number will be the mino type + 1 since we can't have it
+      // as zero (if the type == MINO_T).
+      setCell(gridX, gridY, tetrimino.getShape() + 1);
+    }
+  }
+}
+
+bool MinoGrid::isValidRowNumber(int rowNumber) const {
+  return rowNumber >= 0 && rowNumber < height;
+}
+
+bool MinoGrid::operator==(const MinoGrid &other) const {
+  // The occupancy masks and the skyline follow from the colors
+  return memcmp(colors, other.colors, sizeof(colors)) == 0;
+}
+
+bool MinoGrid::isRowComplete(int rowNumber) const {
+  if (!isValidRowNumber(rowNumber)) {
+    return false; // Invalid row index
+  }
+
+  return rows[rowNumber] == ROW_FULL;
+}
+
+RowList MinoGrid::getCompletedRows() const {
+  RowList completedRows;
+
+  for (int row = height - 1; row >= 0; row--) {
+    if (rows[row] == ROW_FULL) {
+      completedRows.add(row);
+    }
+  }
+
+  return completedRows;
+}
+
+RowList MinoGrid::getCompletedRows(const Tetrimino &tetrimino) const {
+  const RotationData &data = tetrimino.getRotationData();
+  int top = std::max(tetrimino.getRow() + data.minY, 0);
+  int bottom = std::min(tetrimino.getRow() + data.maxY, (int)height - 1);
+
+  RowList completedRows;
+
+  for (int row = bottom; row >= top; row--) {
+    if (rows[row] == ROW_FULL) {
+      completedRows.add(row);
+    }
+  }
+
+  return completedRows;
+}
+
+int MinoGrid::removeCompletedRows() {
+  int writeRow = height - 1; // Start from bottom
+
+  // Move every non-completed row down over the completed ones, from bottom to top
+  for (int readRow = height - 1; readRow >= 0; --readRow) {
+    if (rows[readRow] == ROW_FULL) {
+      continue;
+    }
+
+    if (writeRow != readRow) {
+      rows[writeRow] = rows[readRow];
+      memcpy(colors[writeRow], colors[readRow], sizeof(colors[readRow]));
+    }
+    --writeRow;
+  }
+
+  int rowsCleared = writeRow + 1;
+
+  // Fill remaining top rows with empty ones
+  for (int row = 0; row < rowsCleared; row++) {
+    rows[row] = ROW_EMPTY;
+    memset(colors[row], 0, sizeof(colors[row]));
+  }
+
+  if (rowsCleared > 0) {
+    updateSkyline();
+  }
+
+  return rowsCleared;
+}
+
+// Only the rows from the top of the stack down are saved, with the colors of 2 squares per byte.
+void MinoGrid::saveState(ByteWriter &writer) const {
+  int top = 0;
+  while (top < height && rows[top] == ROW_EMPTY) {
+    top++;
+  }
+
+  writer.putU8(top);
+
+  for (int row = top; row < height; row++) {
+    for (int col = 0; col < width; col += 2) {
+      writer.putU8(colors[row][col] | colors[row][col + 1] << 4);
+    }
+  }
+}
+
+bool MinoGrid::loadState(ByteReader &reader) {
+  clear();
+
+  int top = reader.getU8();
+  if (top > height) {
+    return false;
+  }
+
+  for (int row = top; row < height; row++) {
+    for (int col = 0; col < width; col += 2) {
+      uint8_t pair = reader.getU8();
+      int left = pair & 0xF;
+      int right = pair >> 4;
+
+      if (left > NUMBER_OF_SHAPES || right > NUMBER_OF_SHAPES) {
+        return false;
+      }
+
+      setCell(col, row, left);
+      setCell(col + 1, row, right);
+    }
+  }
+
+  return !reader.hasFailed();
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "byte_stream.h"
+#include "tetrimino.h"
+#include <cstdint>
+#include <vector>
+
+// Number of squares in the playfield grid. There are 10x20 squares where minos can be placed.
+#define GRID_WIDTH 10u
+#define GRID_HEIGHT 20u
+
+// The grid is stored as a bitboard: every row is a 16 bit occupancy mask, using the same "leftmost
+// square is the highest bit" order as the tetrimino bitmasks. The 10 playfield columns live in bits
+// 12 to 3 (column 0 is bit 12) and the 3 bits on each side are always set, acting as walls. This
+// way a complete row is simply 0xFFFF and hitting a wall is just another overlapping bit.
+//
+//   bit:  15 14 13 | 12 11 10  9  8  7  6  5  4  3 |  2  1  0
+//   col:  -3 -2 -1 |  0  1  2  3  4  5  6  7  8  9 | 10 11 12
+#define GRID_WALL_WIDTH 3
+#define ROW_EMPTY 0xE007u // Only the walls are set
+#define ROW_FULL 0xFFFFu  // Walls plus all 10 columns
+#define ROW_FIELD 0x1FF8u // The 10 playfield columns
+
+// Bit for the given column in a row mask
+#define COLUMN_BIT(col) (0x1000u >> (col))
+
+// A list of rows that lives on the stack, with room for every row of the grid. Used for the
+// completed rows, which are looked for after every lock and shouldn't need the heap.
+struct RowList {
+  int8_t rows[GRID_HEIGHT];
+  int count = 0;
+
+  void clear() { count = 0; }
+  void add(int row) { rows[count++] = row; }
+  bool empty() const { return count == 0; }
+  int size() const { return count; }
+  int operator[](int index) const { return rows[index]; }
+  const int8_t *begin() const { return rows; }
+  const int8_t *end() const { return rows + count; }
+
+  bool contains(int row) const {
+    for (int i = 0; i < count; i++) {
+      if (rows[i] == row) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+class MinoGrid {
+private:
+  unsigned int width = GRID_WIDTH;
+  unsigned int height = GRID_HEIGHT;
+
+  // Occupancy of each row. There are 4 extra rows below the playfield that are always full so that
+  // a 4 row slice can be read for any tetrimino that is still inside the grid.
+  uint16_t rows[GRID_HEIGHT + 4];
+
+  // The color plane: mino type + 1 for every occupied square, 0 for empty ones. It's only needed
+  // for drawing, all the game rules look at the occupancy masks.
+  uint8_t colors[GRID_HEIGHT][GRID_WIDTH] = {{0}};
+
+  // The skyline: the row of the highest square of each column, GRID_HEIGHT for empty columns. It's
+  // kept up to date as squares are added and rows removed, so drops don't need to search.
+  uint8_t columnTops[GRID_WIDTH];
+
+  uint64_t rowSlice(int row) const;
+  void updateColumnTop(int col);
+  void updateSkyline();
+
+public:
+  MinoGrid() {
+    clear();
+
+    setCell(9, 19, 2);
+    setCell(8, 19, 3);
+    setCell(7, 19, 4);
+    setCell(6, 19, 2);
+    setCell(5, 19, 3);
+    setCell(4, 19, 4);
+    setCell(3, 19, 4);
+    setCell(2, 19, 4);
+    setCell(1, 19, 4);
+  }
+  ~MinoGrid() = default;
+
+  // Functions that don't modify the grid matrix
+  bool isRowComplete(int rowNumber) const;
+  bool isValidRowNumber(int rowNumber) const;
+  // Completed rows from the bottom of the grid up. { 19, 18, 17, ... }
+  RowList getCompletedRows() const;
+  // Same, but only looking at the (up to 4) rows the tetrimino is in. Rows can only be completed
+  // by the tetrimino that was just added, so this is all the game needs after a lock.
+  RowList getCompletedRows(const Tetrimino &tetrimino) const;
+  int getCell(int col, int row) const { return colors[row][col]; }
+  bool isOccupied(int col, int row) const { return rows[row] & COLUMN_BIT(col); }
+  uint16_t getRowMask(int row) const { return rows[row]; }
+  int getColumnTop(int col) const { return columnTops[col]; }
+  // Same minos in the same squares, with the same colors
+  bool operator==(const MinoGrid &other) const;
+
+  // Returns true if a tetrimino with the given rotation would overlap existing minos or end up
+  // outside of the playfield (left, right or below) when placed at col, row.
+  bool collides(const RotationData &rotation, int col, int row) const;
+  bool TetriminoOverlapping(const Tetrimino &tetrimino) const;
+
+  // Rotates a piece one step in the given direction, using the SRS wall kicks if it doesn't fit
+  // where it is. Returns false, leaving rotation, col and row untouched, if no kick fits either.
+  bool rotatePiece(TETRIMINO_SHAPE shape, int &rotation, int &col, int &row,
+                   ROTATE_DIRECTION direction) const;
+  bool isTouchingLeft(const Tetrimino &tetrimino) const;
+  bool isTouchingRight(const Tetrimino &tetrimino) const;
+  bool isTouchingDown(const Tetrimino &tetrimino) const;
+  // Rows the tetrimino can still fall before touching down (where a hard drop would take it). When
+  // the tetrimino is above the stack this comes straight from the skyline.
+  int getDropDistance(const Tetrimino &tetrimino) const;
+
+  // Functions that modify the grid matrix
+  void clear();
+  void setCell(int col, int row, int value);
+  int removeCompletedRows();
+  void addTetrimino(const Tetrimino &tetrimino);
+
+  // Saved game states (see Game::saveState)
+  void saveState(ByteWriter &writer) const;
+  bool loadState(ByteReader &reader);
+};
@@ -0,0 +1,114 @@
+#include "move_generator.h"
+#include <cstring>
+
+bool MoveGenerator::isVisited(int rotation, int col, int row) const {
+  return visited[rotation][row - MOVE_TOP_ROW] & (1u << (col + GRID_WALL_WIDTH));
+}
+
+void MoveGenerator::visit(int rotation, int col, int row, PIECE_MOVE move, int parent) {
+  if (row < MOVE_TOP_ROW || isVisited(rotation, col, row)) {
+    return;
+  }
+
+  visited[rotation][row - MOVE_TOP_ROW] |= 1u << (col + GRID_WALL_WIDTH);
+  nodes[nodeCount++] = {(int8_t)rotation, (int8_t)col, (int8_t)row, (int8_t)move,
+                        (int16_t)parent};
+}
+
+// Breadth first search over every (rotation, col, row) the piece can be moved to. A node that can't
+// move down anymore is a placement.
+int MoveGenerator::generate(const MinoGrid &grid, const Tetrimino &piece) {
+  shape = piece.getShape();
+  nodeCount = 0;
+  placementCount = 0;
+  memset(visited, 0, sizeof(visited));
+  memset(placed, 0, sizeof(placed));
+
+  if (grid.TetriminoOverlapping(piece)) {
+    return 0;
+  }
+
+  // Above the stack only the walls can get in the way, so moving and rotating there gives the same
+  // results on any row. Instead of exploring all those rows one by one, pieces fall straight to the
+  // lowest one that is still clear of the stack, for every rotation and even after a wall kick
+  // (4 rows of piece, plus up to 2 rows of kick).
+  int skyRow = 0;
+  while (skyRow < (int)GRID_HEIGHT && grid.getRowMask(skyRow) == ROW_EMPTY) {
+    skyRow++;
+  }
+  skyRow -= 6;
+
+  visit(piece.getRotationIndex(), piece.getCol(), piece.getRow(), MOVE_DOWN, -1);
+
+  for (int i = 0; i < nodeCount; i++) {
+    Node node = nodes[i];
+    const RotationData &data = PIECE_TABLE.rotations[shape][node.rotation];
+
+    // Most neighbours were already reached some other way, which is cheaper to check than the
+    // collisions. A column past the walls always collides, so it's never looked up as visited.
+    if (node.col > -GRID_WALL_WIDTH && !isVisited(node.rotation, node.col - 1, node.row) &&
+        !grid.collides(data, node.col - 1, node.row)) {
+      visit(node.rotation, node.col - 1, node.row, MOVE_LEFT, i);
+    }
+
+    if (node.col < (int)GRID_WIDTH - 1 && !isVisited(node.rotation, node.col + 1, node.row) &&
+        !grid.collides(data, node.col + 1, node.row)) {
+      visit(node.rotation, node.col + 1, node.row, MOVE_RIGHT, i);
+    }
+
+    int rotation = node.rotation;
+    int col = node.col;
+    int row = node.row;
+
+    if (grid.rotatePiece(shape, rotation, col, row, RIGHT)) {
+      visit(rotation, col, row, MOVE_ROTATE, i);
+    }
+
+    // Falling goes last, so when there is more than one shortest way to a position the one that
+    // moves sideways and rotates first (while the piece is still high) is kept
+    if (grid.collides(data, node.col, node.row + 1)) {
+      int col = node.col + data.sameAsX;
+      int row = node.row + data.sameAsY;
+      uint32_t &placedCols = placed[data.sameAs][row - MOVE_TOP_ROW + 3];
+      uint32_t bit = 1u << (col + 2 * GRID_WALL_WIDTH);
+
+      if (!(placedCols & bit)) {
+        placedCols |= bit;
+        placements[placementCount++] = {node.rotation, node.col, node.row, (int16_t)i};
+      }
+    } else {
+      int below = node.row < skyRow ? skyRow : node.row + 1;
+
+      if (!isVisited(node.rotation, node.col, below)) {
+        visit(node.rotation, node.col, below, MOVE_DOWN, i);
+      }
+    }
+  }
+
+  return placementCount;
+}
+
+int MoveGenerator::getPath(const Placement &placement, PIECE_MOVE *moves, int maxMoves) const {
+  int count = 0;
+
+  // Falling above the stack can skip rows in a single step, it's still one move per row
+  for (int node = placement.node; nodes[node].parent >= 0; node = nodes[node].parent) {
+    count += nodes[node].move == MOVE_DOWN ? nodes[node].row - nodes[nodes[node].parent].row : 1;
+  }
+
+  // Walk back from the placement, writing the moves from the end
+  int index = count;
+  for (int node = placement.node; nodes[node].parent >= 0; node = nodes[node].parent) {
+    const Node &parent = nodes[nodes[node].parent];
+    int repeat = nodes[node].move == MOVE_DOWN ? nodes[node].row - parent.row : 1;
+
+    for (int i = 0; i < repeat; i++) {
+      index--;
+      if (index < maxMoves) {
+        moves[index] = (PIECE_MOVE)nodes[node].move;
+      }
+    }
+  }
+
+  return count < maxMoves ? count : maxMoves;
+}
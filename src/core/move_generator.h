@@ -0,0 +1,73 @@
+#pragma once
+
+#include "mino_grid.h"
+#include "tetrimino.h"
+#include <cstdint>
+
+// The moves a piece can make, the same ones the player has: the game only rotates to the right
+typedef enum PIECE_MOVE { MOVE_LEFT = 0, MOVE_RIGHT, MOVE_DOWN, MOVE_ROTATE } PIECE_MOVE;
+
+// Positions a piece can be in while searching. Pieces can be kicked a bit above the playfield, but
+// not more than MOVE_TOP_ROW rows.
+#define MOVE_TOP_ROW -4
+#define MOVE_COLS (GRID_WIDTH + GRID_WALL_WIDTH)
+#define MOVE_ROWS (GRID_HEIGHT - MOVE_TOP_ROW)
+#define MOVE_MAX_NODES (NUMBER_OF_ROTATIONS * MOVE_ROWS * MOVE_COLS)
+
+// A position where a piece comes to rest and would lock
+struct Placement {
+  int8_t rotation;
+  int8_t col;
+  int8_t row;
+  int16_t node; // The search node that reached it, to rebuild the moves that lead here
+};
+
+// Finds every position a piece can reach and lock in, moving left, right, down and rotating (with
+// wall kicks) from where it is now. Tucks under overhangs and spins are found too, since every
+// reachable position is explored. Placements that cover the same squares (the rotations of O, S, Z
+// and I that look the same) are only listed once.
+//
+// Everything is kept in fixed arrays that are reused between calls, so a generator can be called
+// again and again without allocating.
+class MoveGenerator {
+private:
+  struct Node {
+    int8_t rotation;
+    int8_t col;
+    int8_t row;
+    int8_t move;    // The PIECE_MOVE that reached this node
+    int16_t parent; // -1 for the starting position
+  };
+
+  TETRIMINO_SHAPE shape = TETRIMINO_T;
+
+  Node nodes[MOVE_MAX_NODES];
+  int nodeCount = 0;
+
+  // A bit per column for every rotation and row, for the positions already explored
+  uint16_t visited[NUMBER_OF_ROTATIONS][MOVE_ROWS];
+
+  // Same for the placements, using the first rotation with the same squares. That rotation can be
+  // up to 3 squares away in any direction, hence the extra room.
+  uint32_t placed[NUMBER_OF_ROTATIONS][MOVE_ROWS + 6];
+
+  Placement placements[MOVE_MAX_NODES];
+  int placementCount = 0;
+
+  bool isVisited(int rotation, int col, int row) const;
+  void visit(int rotation, int col, int row, PIECE_MOVE move, int parent);
+
+public:
+  // Searches all the placements of the piece from its current position. Returns how many there are.
+  int generate(const MinoGrid &grid, const Tetrimino &piece);
+
+  TETRIMINO_SHAPE getShape() const { return shape; }
+  int getPlacementCount() const { return placementCount; }
+  const Placement &getPlacement(int index) const { return placements[index]; }
+  const Placement *begin() const { return placements; }
+  const Placement *end() const { return placements + placementCount; }
+
+  // The shortest list of moves from the starting position to the placement. Returns how many
+  // moves were written (at most maxMoves, the first ones).
+  int getPath(const Placement &placement, PIECE_MOVE *moves, int maxMoves) const;
+};
@@ -0,0 +1,293 @@
+#include "replay.h"
+#include <cstring>
+
+ReplayRecorder::ReplayRecorder()
+    : buffer(REPLAY_BUFFER_SIZE), index(REPLAY_INDEX_CAPACITY), keyframe(REPLAY_BUFFER_SIZE) {}
+
+ReplayRecorder::~ReplayRecorder() {
+  // Not finished, whatever was recorded is kept but the file can't be played back
+  if (file) {
+    flush();
+    fclose(file);
+  }
+}
+
+bool ReplayRecorder::open(const std::string &path, const Game &game, uint64_t seed) {
+  // The previous recording is left like the destructor leaves it
+  if (file) {
+    flush();
+    fclose(file);
+    file = nullptr;
+  }
+
+  file = fopen(path.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+
+  buffer.clear();
+  index.clear();
+  fileSize = 0;
+  keyframeInterval = REPLAY_KEYFRAME_SECONDS * game.getTickRate();
+  keyframeCount = 0;
+  nextKeyframeTick = keyframeInterval;
+  runInputs = 0;
+  runLength = 0;
+
+  buffer.putBytes((const uint8_t *)REPLAY_MAGIC, 4);
+  buffer.putU8(REPLAY_VERSION);
+  buffer.putU8(0);
+  buffer.putU16(game.getTickRate());
+  buffer.putU32(keyframeInterval);
+  buffer.putU64(seed);
+
+  return true;
+}
+
+void ReplayRecorder::writeRun() {
+  if (runLength == 0) {
+    return;
+  }
+
+  if (runLength <= REPLAY_SHORT_RUN_MAX) {
+    buffer.putU8(runInputs | (runLength - 1) << 5);
+  } else {
+    buffer.putU8(runInputs | REPLAY_LONG_RUN);
+    buffer.putVarint(runLength);
+  }
+
+  runLength = 0;
+}
+
+void ReplayRecorder::writeKeyframe(const Game &game) {
+  keyframe.clear();
+  game.saveState(keyframe);
+
+  index.putU32(game.getTickCount());
+  index.putU32(fileSize + buffer.size());
+  keyframeCount++;
+
+  buffer.putU8(REPLAY_KEYFRAME);
+  buffer.putVarint(keyframe.size());
+  buffer.putBytes(keyframe.bytes(), keyframe.size());
+}
+
+void ReplayRecorder::flush() {
+  fwrite(buffer.bytes(), 1, buffer.size(), file);
+  fileSize += buffer.size();
+  buffer.clear();
+}
+
+void ReplayRecorder::record(const Game &game, uint8_t inputs) {
+  if (!file) {
+    return;
+  }
+
+  inputs &= REPLAY_INPUT_MASK;
+
+  if (game.getTickCount() >= nextKeyframeTick) {
+    writeRun();
+    writeKeyframe(game);
+    nextKeyframeTick += keyframeInterval;
+  }
+
+  if (inputs != runInputs) {
+    writeRun();
+    runInputs = inputs;
+  }
+  runLength++;
+
+  // A keyframe is the biggest thing written at once, well under 256 bytes
+  if (buffer.size() > REPLAY_BUFFER_SIZE - 256) {
+    flush();
+  }
+}
+
+bool ReplayRecorder::finish(const Game &game) {
+  if (!file) {
+    return false;
+  }
+
+  writeRun();
+
+  long indexOffset = fileSize + buffer.size();
+  buffer.putBytes(index.bytes(), index.size());
+
+  buffer.putU32(indexOffset);
+  buffer.putU32(keyframeCount);
+  buffer.putU32(game.getTickCount());
+  buffer.putU32(game.getPieceCount());
+  buffer.putU64(game.getScore());
+  buffer.putU32(game.getLinesCleared());
+  buffer.putU16(game.getLevel());
+  buffer.putU8(game.isToppedOut());
+  buffer.putU8(0);
+  buffer.putBytes((const uint8_t *)REPLAY_END_MAGIC, 4);
+
+  flush();
+  bool ok = ferror(file) == 0;
+  ok = fclose(file) == 0 && ok;
+  file = nullptr;
+
+  return ok;
+}
+
+bool Replay::open(const std::string &path) {
+  if (!file.open(path)) {
+    return false;
+  }
+
+  const uint8_t *data = file.getData();
+  size_t size = file.getSize();
+
+  if (size < REPLAY_HEADER_SIZE + REPLAY_TRAILER_SIZE || memcmp(data, REPLAY_MAGIC, 4) != 0 ||
+      memcmp(data + size - 4, REPLAY_END_MAGIC, 4) != 0) {
+    file.close();
+    return false;
+  }
+
+  ByteReader header(data + 4, REPLAY_HEADER_SIZE - 4);
+  int version = header.getU8();
+  header.getU8();
+  tickRate = header.getU16();
+  keyframeInterval = header.getU32();
+  seed = header.getU64();
+
+  ByteReader trailer(data + size - REPLAY_TRAILER_SIZE, REPLAY_TRAILER_SIZE);
+  streamEnd = trailer.getU32();
+  keyframeCount = trailer.getU32();
+  summary.ticks = trailer.getU32();
+  summary.pieces = trailer.getU32();
+  summary.score = trailer.getU64();
+  summary.lines = trailer.getU32();
+  summary.level = trailer.getU16();
+  summary.toppedOut = trailer.getU8();
+
+  size_t indexSize = (size_t)keyframeCount * REPLAY_INDEX_ENTRY_SIZE;
+
+  if (version != REPLAY_VERSION || tickRate == 0 || streamEnd < REPLAY_HEADER_SIZE ||
+      streamEnd + indexSize != size - REPLAY_TRAILER_SIZE) {
+    file.close();
+    return false;
+  }
+
+  keyframeIndex = data + streamEnd;
+  return true;
+}
+
+long Replay::getKeyframeTick(int keyframe) const {
+  return ByteReader(keyframeIndex + keyframe * REPLAY_INDEX_ENTRY_SIZE, 4).getU32();
+}
+
+size_t Replay::getKeyframeOffset(int keyframe) const {
+  return ByteReader(keyframeIndex + keyframe * REPLAY_INDEX_ENTRY_SIZE + 4, 4).getU32();
+}
+
+int Replay::findKeyframe(long tick) const {
+  int low = 0;
+  int high = keyframeCount;
+
+  // Binary search for the first keyframe after the tick
+  while (low < high) {
+    int middle = (low + high) / 2;
+
+    if (getKeyframeTick(middle) <= tick) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  return low - 1;
+}
+
+ReplayPlayer::ReplayPlayer(const Replay &replay)
+    : replay(replay), reader(replay.getData() + replay.getStreamStart(),
+                             replay.getStreamEnd() - replay.getStreamStart()) {}
+
+void ReplayPlayer::restart(Game &game) {
+  game = replay.createGame();
+  reader = ByteReader(replay.getData() + replay.getStreamStart(),
+                      replay.getStreamEnd() - replay.getStreamStart());
+  tick = 0;
+  runLeft = 0;
+}
+
+bool ReplayPlayer::loadKeyframe(int keyframe, Game &game) {
+  size_t offset = replay.getKeyframeOffset(keyframe);
+  if (offset < replay.getStreamStart() || offset >= replay.getStreamEnd()) {
+    return false;
+  }
+
+  ByteReader keyframeReader(replay.getData() + offset, replay.getStreamEnd() - offset);
+  keyframeReader.getU8();
+  size_t stateSize = keyframeReader.getVarint();
+
+  ByteReader stateReader(keyframeReader.position(), keyframeReader.remaining());
+  Game keyframeGame = replay.createGame();
+  if (!keyframeGame.loadState(stateReader)) {
+    return false;
+  }
+
+  keyframeReader.skip(stateSize);
+  if (keyframeReader.hasFailed()) {
+    return false;
+  }
+
+  game = keyframeGame;
+  reader = keyframeReader;
+  tick = replay.getKeyframeTick(keyframe);
+  runLeft = 0;
+  return true;
+}
+
+void ReplayPlayer::seek(long targetTick, Game &game) {
+  int keyframe = replay.findKeyframe(targetTick);
+
+  // Only jump to the keyframe if it saves time, going forward from where we are might be shorter
+  bool loaded = false;
+  if (keyframe >= 0 && (targetTick < tick || replay.getKeyframeTick(keyframe) > tick)) {
+    loaded = loadKeyframe(keyframe, game);
+  }
+
+  if (!loaded && targetTick < tick) {
+    restart(game);
+  }
+
+  while (tick < targetTick && !isFinished() && !game.isToppedOut()) {
+    game.step(nextInputs(game));
+  }
+}
+
+uint8_t ReplayPlayer::nextInputs(const Game &) {
+  while (runLeft == 0) {
+    if (reader.remaining() == 0) {
+      return 0;
+    }
+
+    uint8_t record = reader.getU8();
+
+    if (record == REPLAY_KEYFRAME) {
+      // Only needed when seeking
+      reader.skip(reader.getVarint());
+    } else if ((record >> 5) < REPLAY_SHORT_RUN_MAX) {
+      runInputs = record & REPLAY_INPUT_MASK;
+      runLeft = (record >> 5) + 1;
+    } else if ((record >> 5) == REPLAY_LONG_RUN >> 5) {
+      runInputs = record & REPLAY_INPUT_MASK;
+      runLeft = reader.getVarint();
+    } else {
+      // Not a valid record, the rest of the stream can't be trusted
+      reader.skip(reader.remaining());
+    }
+
+    if (reader.hasFailed()) {
+      runLeft = 0;
+      return 0;
+    }
+  }
+
+  runLeft--;
+  tick++;
+  return runInputs;
+}
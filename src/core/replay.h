@@ -0,0 +1,147 @@
+#pragma once
+
+#include "byte_stream.h"
+#include "game.h"
+#include "input_source.h"
+#include "mapped_file.h"
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Replay files (.rkr). Everything is little-endian.
+//
+//   header   "RKRP", u8 version, u8 unused, u16 tick rate, u32 keyframe interval, u64 seed
+//   stream   records, one after the other:
+//              [inputs | (count - 1) << 5]                 count (1 to 6) ticks with these inputs
+//              [inputs | 0xC0] [varint count]              count ticks with these inputs
+//              [0xFF] [varint size] [Game::saveState]      keyframe: the game state at this tick
+//   index    u32 tick, u32 offset of the record, for each keyframe
+//   trailer  u32 index offset, u32 keyframe count, u32 ticks, u32 pieces, u64 score, u32 lines,
+//            u16 level, u8 topped out, u8 unused, "RKRE"
+//
+// The inputs only change a few times per second, so most of a game fits in a couple of bytes per
+// key press. The trailer has a fixed size and sits at the end of the file, so the summary and the
+// keyframes can be found without reading the stream.
+#define REPLAY_MAGIC "RKRP"
+#define REPLAY_END_MAGIC "RKRE"
+#define REPLAY_VERSION 1
+#define REPLAY_HEADER_SIZE 20
+#define REPLAY_TRAILER_SIZE 36
+#define REPLAY_INDEX_ENTRY_SIZE 8
+
+#define REPLAY_LONG_RUN 0xC0u
+#define REPLAY_KEYFRAME 0xFFu
+#define REPLAY_INPUT_MASK 0x1Fu
+#define REPLAY_SHORT_RUN_MAX 6
+
+#define REPLAY_KEYFRAME_SECONDS 20 // Seeking never simulates more than this
+#define REPLAY_BUFFER_SIZE 4096    // Bytes kept in memory before writing them to the file
+#define REPLAY_INDEX_CAPACITY 2048 // Index bytes reserved up front, keyframes for over an hour
+
+// How a recorded game ended
+struct ReplaySummary {
+  long ticks = 0;
+  long pieces = 0;
+  long score = 0;
+  int lines = 0;
+  int level = 0;
+  bool toppedOut = false;
+};
+
+// Writes a replay while a game is being played. Call record() right before every Game::step with
+// the same inputs, and finish() once the game is over. The file is only ever appended to, and only
+// when the small buffer fills up, so recording costs next to nothing per tick.
+class ReplayRecorder {
+private:
+  FILE *file = nullptr;
+  ByteWriter buffer;
+  ByteWriter index;
+  ByteWriter keyframe; // Reused for every keyframe, so recording doesn't allocate as it goes
+  long fileSize = 0; // Bytes already written to the file
+  int keyframeInterval = 0;
+  int keyframeCount = 0;
+  long nextKeyframeTick = 0;
+
+  uint8_t runInputs = 0;
+  uint64_t runLength = 0;
+
+  void writeRun();
+  void writeKeyframe(const Game &game);
+  void flush();
+
+public:
+  ReplayRecorder();
+  ~ReplayRecorder();
+
+  ReplayRecorder(const ReplayRecorder &) = delete;
+  ReplayRecorder &operator=(const ReplayRecorder &) = delete;
+
+  // Starts recording a game that was just created with this seed
+  bool open(const std::string &path, const Game &game, uint64_t seed);
+  void record(const Game &game, uint8_t inputs);
+  // Writes the keyframe index and the summary. Without it the replay can't be opened.
+  bool finish(const Game &game);
+
+  bool isRecording() const { return file != nullptr; }
+};
+
+// A replay file, mapped into memory. Opening it only checks the header and the trailer.
+class Replay {
+private:
+  MappedFile file;
+  uint64_t seed = 0;
+  int tickRate = 0;
+  int keyframeInterval = 0;
+  int keyframeCount = 0;
+  size_t streamEnd = 0;
+  const uint8_t *keyframeIndex = nullptr;
+  ReplaySummary summary;
+
+public:
+  bool open(const std::string &path);
+
+  uint64_t getSeed() const { return seed; }
+  int getTickRate() const { return tickRate; }
+  int getKeyframeCount() const { return keyframeCount; }
+  const ReplaySummary &getSummary() const { return summary; }
+
+  // A new game with the seed and tick rate of the recorded one
+  Game createGame() const { return Game(seed, tickRate); }
+
+  const uint8_t *getData() const { return file.getData(); }
+  size_t getStreamStart() const { return REPLAY_HEADER_SIZE; }
+  size_t getStreamEnd() const { return streamEnd; }
+
+  // Tick and file offset of a keyframe
+  long getKeyframeTick(int keyframe) const;
+  size_t getKeyframeOffset(int keyframe) const;
+  // The last keyframe at or before the tick, -1 if there is none
+  int findKeyframe(long tick) const;
+};
+
+// Plays a replay back, giving the game the recorded inputs one tick at a time
+class ReplayPlayer : public InputSource {
+private:
+  const Replay &replay;
+  ByteReader reader;
+  long tick = 0; // Ticks played so far
+
+  uint8_t runInputs = 0;
+  uint64_t runLeft = 0;
+
+  bool loadKeyframe(int keyframe, Game &game);
+
+public:
+  explicit ReplayPlayer(const Replay &replay);
+
+  // Goes back to the start. The game is replaced by a new one with the recorded seed.
+  void restart(Game &game);
+  // Moves the game to the given tick, starting from the closest keyframe before it (or from where
+  // the game is now, if that is closer)
+  void seek(long targetTick, Game &game);
+
+  uint8_t nextInputs(const Game &game) override;
+
+  long getTick() const { return tick; }
+  bool isFinished() const { return runLeft == 0 && reader.remaining() == 0; }
+};
@@ -0,0 +1,47 @@
+#include "tetrimino.h"
+
+void Tetrimino::Rotate(ROTATE_DIRECTION direction) {
+  int newIndex = 0;
+
+  switch (direction) {
+  case LEFT:
+    newIndex = (rotationIndex - 1) % NUMBER_OF_ROTATIONS;
+    break;
+  case RIGHT:
+    newIndex = (rotationIndex + 1) % NUMBER_OF_ROTATIONS;
+    break;
+  }
+
+  if (newIndex < 0) {
+    newIndex = NUMBER_OF_ROTATIONS - 1;
+  }
+
+  rotationIndex = newIndex;
+}
+
+void Tetrimino::saveState(ByteWriter &writer) const {
+  writer.putU8(shape);
+  writer.putU8(rotationIndex);
+  writer.putSignedVarint(col);
+  writer.putSignedVarint(row);
+  writer.putU8(locked);
+  writer.putVarint(lockTimer);
+}
+
+bool Tetrimino::loadState(ByteReader &reader) {
+  int newShape = reader.getU8();
+  int newRotation = reader.getU8();
+
+  if (newShape >= NUMBER_OF_SHAPES || newRotation >= NUMBER_OF_ROTATIONS) {
+    return false;
+  }
+
+  shape = (TETRIMINO_SHAPE)newShape;
+  rotationIndex = newRotation;
+  col = reader.getSignedVarint();
+  row = reader.getSignedVarint();
+  locked = reader.getU8();
+  lockTimer = reader.getVarint();
+
+  return !reader.hasFailed();
+}
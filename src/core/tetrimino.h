@@ -0,0 +1,65 @@
+#pragma once
+
+#include "byte_stream.h"
+#include "tetrimino_data.h"
+
+class Tetrimino {
+private:
+  TETRIMINO_SHAPE shape;
+  int rotationIndex;
+  bool locked; // This is used to check if the tetrimino is locked in place and cannot move anymore
+  int lockTimer = 0; // Steps spent on the ground, for locking the tetrimino in place
+  int col;
+  int row;
+
+public:
+  explicit Tetrimino(TETRIMINO_SHAPE shape = TETRIMINO_T) : shape(shape) { reset(); }
+
+  // Decoded data for the current rotation (occupied squares, row masks, bounding box)
+  const RotationData &getRotationData() const {
+    return PIECE_TABLE.rotations[shape][rotationIndex];
+  }
+  int getRotation() const { return getRotationData().mask; }
+  int getRotationIndex() const { return rotationIndex; }
+
+  // Resets the tetrimino values. The default col is 3 because it's the center of the playfield.
+  void reset() {
+    row = 0;
+    col = 3;
+    locked = false;
+    rotationIndex = 0;
+    lockTimer = 0;
+  }
+
+  ~Tetrimino() = default;
+  void moveLeft() { col--; }
+  void moveRight() { col++; }
+  void moveDown() { row++; }
+  int getCol() const { return col; }
+  int getRow() const { return row; }
+  void setCol(int newCol) { col = newCol; }
+  void setRow(int newRow) { row = newRow; }
+  void setRotation(int newRotation) {
+    if (newRotation < 0) {
+      newRotation = NUMBER_OF_ROTATIONS - 1;
+    } else if (newRotation >= NUMBER_OF_ROTATIONS) {
+      newRotation = 0;
+    }
+    rotationIndex = newRotation;
+  }
+  TETRIMINO_SHAPE getShape() const { return shape; }
+  void Rotate(ROTATE_DIRECTION direction);
+  bool isLocked() const { return locked; }
+  void lock() {
+    locked = true;
+    resetLockTimer();
+  }
+  void resetLockTimer() { lockTimer = 0; }
+  void addToLockTimer() { lockTimer++; }
+  int getLockTimer() const { return lockTimer; }
+  bool isLocking() const { return lockTimer > 0; }
+
+  // Saved game states (see Game::saveState)
+  void saveState(ByteWriter &writer) const;
+  bool loadState(ByteReader &reader);
+};
@@ -0,0 +1,104 @@
+#include "tetrimino_bag.h"
+
+// SplitMix64 (https://prng.di.unimi.it/splitmix64.c), reduced to [0, bound) with a multiply-shift
+uint32_t TetriminoBag::nextRandom(uint32_t bound) {
+  uint64_t z = (rngState += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  z = z ^ (z >> 31);
+
+  return (uint32_t)(((z >> 32) * bound) >> 32);
+}
+
+// Appends a new shuffled bag to the queue of upcoming pieces
+void TetriminoBag::refillBag() {
+  TETRIMINO_SHAPE bag[NUMBER_OF_SHAPES] = {TETRIMINO_I, TETRIMINO_O, TETRIMINO_T, TETRIMINO_S,
+                                           TETRIMINO_Z, TETRIMINO_J, TETRIMINO_L};
+
+  // Shuffle the bag (Fisher-Yates)
+  for (int i = NUMBER_OF_SHAPES - 1; i > 0; i--) {
+    int j = nextRandom(i + 1);
+    TETRIMINO_SHAPE tmp = bag[i];
+    bag[i] = bag[j];
+    bag[j] = tmp;
+  }
+
+  for (int i = 0; i < NUMBER_OF_SHAPES; i++) {
+    queue[(queueStart + queueSize) % BAG_QUEUE_SIZE] = bag[i];
+    queueSize++;
+  }
+}
+
+TETRIMINO_SHAPE TetriminoBag::getNextShape() {
+  if (queueSize == 0) {
+    refillBag();
+  }
+  if (remaining == 0) {
+    remaining = NUMBER_OF_SHAPES;
+  }
+
+  TETRIMINO_SHAPE nextShape = queue[queueStart];
+  queueStart = (queueStart + 1) % BAG_QUEUE_SIZE;
+  queueSize--;
+  remaining--;
+  return nextShape;
+}
+
+// Preview next N pieces without consuming them. Bags needed for the preview are shuffled right
+// away, so the preview is always exactly what getNextShape() will return later.
+std::vector<TETRIMINO_SHAPE> TetriminoBag::preview(int count) {
+  TETRIMINO_SHAPE shapes[BAG_QUEUE_SIZE];
+  count = preview(shapes, count);
+
+  return std::vector<TETRIMINO_SHAPE>(shapes, shapes + count);
+}
+
+int TetriminoBag::preview(TETRIMINO_SHAPE *shapes, int count) {
+  if (count > BAG_QUEUE_SIZE - NUMBER_OF_SHAPES + 1) {
+    count = BAG_QUEUE_SIZE - NUMBER_OF_SHAPES + 1;
+  }
+
+  while (queueSize < count) {
+    refillBag();
+  }
+
+  for (int i = 0; i < count; i++) {
+    shapes[i] = queue[(queueStart + i) % BAG_QUEUE_SIZE];
+  }
+
+  return count;
+}
+
+// Get remaining pieces in current bag (for debugging)
+int TetriminoBag::remainingInBag() const { return remaining; }
+
+void TetriminoBag::saveState(ByteWriter &writer) const {
+  writer.putU64(rngState);
+  writer.putU8(remaining);
+  writer.putU8(queueSize);
+
+  for (int i = 0; i < queueSize; i++) {
+    writer.putU8(queue[(queueStart + i) % BAG_QUEUE_SIZE]);
+  }
+}
+
+bool TetriminoBag::loadState(ByteReader &reader) {
+  rngState = reader.getU64();
+  remaining = reader.getU8();
+  queueStart = 0;
+  queueSize = reader.getU8();
+
+  if (remaining > NUMBER_OF_SHAPES || queueSize > BAG_QUEUE_SIZE) {
+    return false;
+  }
+
+  for (int i = 0; i < queueSize; i++) {
+    int shape = reader.getU8();
+    if (shape >= NUMBER_OF_SHAPES) {
+      return false;
+    }
+    queue[i] = (TETRIMINO_SHAPE)shape;
+  }
+
+  return !reader.hasFailed();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "byte_stream.h"
+#include "tetrimino_data.h"
+#include <cstdint>
+#include <vector>
+
+// How many upcoming pieces the bag can hold. Enough for 2 full bags plus whatever is left of the
+// current one, which means we can always preview at least the next 8 pieces.
+#define BAG_QUEUE_SIZE (3 * NUMBER_OF_SHAPES)
+
+// The 7-bag randomizer. Pieces are handed out from shuffled bags of all 7 tetriminos.
+//
+// The bag is fully deterministic: two bags created with the same seed always give the same
+// sequence of pieces, on every platform. That's why it uses its own generator and shuffle instead
+// of std::mt19937 and std::shuffle (the standard distributions are implementation defined).
+class TetriminoBag {
+private:
+  // Upcoming pieces, as a ring buffer. Whole shuffled bags are appended at the back.
+  TETRIMINO_SHAPE queue[BAG_QUEUE_SIZE];
+  int queueStart = 0;
+  int queueSize = 0;
+  int remaining = NUMBER_OF_SHAPES; // Pieces left in the current bag
+  uint64_t rngState;
+
+  void refillBag();
+  uint32_t nextRandom(uint32_t bound);
+
+public:
+  explicit TetriminoBag(uint64_t seed) : rngState(seed) { refillBag(); }
+
+  TETRIMINO_SHAPE getNextShape();
+
+  // Preview next N pieces without consuming them
+  std::vector<TETRIMINO_SHAPE> preview(int count);
+  // Same, written to shapes (room for count of them) instead of a new vector. Returns how many were
+  // written, which is less than count if it's more than the bag can preview.
+  int preview(TETRIMINO_SHAPE *shapes, int count);
+
+  // Get remaining pieces in current bag (for debugging)
+  int remainingInBag() const;
+
+  // Saved game states (see Game::saveState)
+  void saveState(ByteWriter &writer) const;
+  bool loadState(ByteReader &reader);
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstdint>
+
+#define NUMBER_OF_ROTATIONS 4
+#define NUMBER_OF_SHAPES 7
+
+// Because a tetromino is basically a set of 'big pixels' that can be either on or off, it is quite
+// suitable and efficient to represent it as a bitmask rather than a matrix of integers.
+//
+// Example for the S shape:
+//
+// X . . .     1 0 0 0
+// X X . .  =  1 1 0 0  =  1000110001000000 (in binary)  =  0x8C40 (in hexadecimal)
+// . X . .     0 1 0 0
+// . . . .     0 0 0 0
+//
+// . X X .     0 1 1 0
+// X X . .  =  1 1 0 0  =  0110110000000000 (in binary)  =  0x6C00 (in hexadecimal)
+// . . . .     0 0 0 0
+// . . . .     0 0 0 0
+//
+// I'm using the Super Rotation System (https://tetris.fandom.com/wiki/SRS) which is what is being
+// used in modern Tetris games.
+inline constexpr int TETRIMINOS[NUMBER_OF_SHAPES][NUMBER_OF_ROTATIONS] = {
+    {0x4E00, 0x4640, 0x0E40, 0x4C40}, // T
+    {0x6C00, 0x4620, 0x06C0, 0x8C40}, // S
+    {0xC600, 0x2640, 0x0C60, 0x4C80}, // Z
+    {0x0F00, 0x2222, 0x00F0, 0x4444}, // I
+    {0x8E00, 0x6440, 0x0E20, 0x44C0}, // J
+    {0x2E00, 0x4460, 0xE800, 0xC440}, // L
+    {0x6600, 0x6600, 0x6600, 0x6600}  // O
+};
+
+// The wall kick data is always an array of 4 pairs of coordinates to replace row & col for the
+// rotating tetrimino.
+typedef int KickData[4][2];
+
+// When the player attempts to rotate a tetromino, but the position it would normally occupy after
+// basic rotation is obstructed, (either by the wall or floor of the playfield, or by the stack),
+// the game will attempt to "kick" the tetromino into an alternative position nearby
+// Wall kick tables taken from https://tetris.fandom.com/wiki/SRS
+//
+// The order is 0->1, 1->0, 1->2, 2->1, 2->3, 3->2, 3->0, 0->3.
+inline constexpr KickData WALL_KICKS[8] = {
+    {{-1, 0}, {-1, 1}, {0, -2}, {-1, -2}}, {{1, 0}, {1, -1}, {0, 2}, {1, 2}},
+    {{1, 0}, {1, -1}, {0, 2}, {1, 2}},     {{-1, 0}, {-1, 1}, {0, -2}, {-1, -2}},
+    {{1, 0}, {1, 1}, {0, -2}, {1, -2}},    {{-1, 0}, {-1, -1}, {0, 2}, {-1, 2}},
+    {{-1, 0}, {-1, -1}, {0, 2}, {-1, 2}},  {{1, 0}, {1, -1}, {0, -2}, {1, -2}}};
+
+// For the I tetrimino the kicks are different
+inline constexpr KickData WALL_KICKS_I[8] = {
+    {{-2, 0}, {1, 0}, {-2, -1}, {1, 2}}, {{2, 0}, {-1, 0}, {2, 1}, {-1, -2}},
+    {{-1, 0}, {2, 0}, {-1, 2}, {2, -1}}, {{1, 0}, {-2, 0}, {1, -2}, {-2, 1}},
+    {{2, 0}, {-1, 0}, {2, 1}, {-1, -2}}, {{-2, 0}, {1, 0}, {-2, -1}, {1, 2}},
+    {{1, 0}, {-2, 0}, {1, -2}, {-2, 1}}, {{-1, 0}, {2, 0}, {-1, 2}, {2, -1}}};
+
+typedef enum TETRIMINO_SHAPE {
+  TETRIMINO_T = 0,
+  TETRIMINO_S,
+  TETRIMINO_Z,
+  TETRIMINO_I,
+  TETRIMINO_J,
+  TETRIMINO_L,
+  TETRIMINO_O
+} TETRIMINO_SHAPE;
+
+typedef enum ROTATE_DIRECTION { LEFT = 0, RIGHT } ROTATE_DIRECTION;
+
+// Position of a single square of a tetrimino, relative to the tetrimino col & row.
+struct MinoOffset {
+  int8_t x;
+  int8_t y;
+};
+
+// Everything we need to know about one rotation of a tetrimino, decoded from its bitmask once at
+// compile time so that the game never has to look at individual bits again.
+struct RotationData {
+  int mask;              // The original bitmask from TETRIMINOS
+  MinoOffset cells[4];   // The 4 occupied squares, top to bottom and left to right
+  uint8_t rowMasks[4];   // Each row of the bitmask, with the leftmost square in bit 3
+  uint64_t slice;        // The row masks in 16 bit lanes (first row in the lowest lane)
+  int8_t minX, maxX;     // Bounding box of the occupied squares
+  int8_t minY, maxY;
+  int8_t bottoms[4];     // Lowest occupied square of each column of the bitmask, -1 if none
+
+  // The first rotation of the shape with the same squares as this one, just moved around: this one
+  // at (col, row) covers the same squares as that one at (col + sameAsX, row + sameAsY). Only O, S,
+  // Z and I have these duplicates, for the others it's the rotation itself.
+  int8_t sameAs;
+  int8_t sameAsX, sameAsY;
+};
+
+struct PieceTable {
+  RotationData rotations[NUMBER_OF_SHAPES][NUMBER_OF_ROTATIONS];
+
+  // The kick tests for rotating a shape [from][to]. Only single step rotations have kicks, the
+  // other entries are null.
+  const KickData *kicks[NUMBER_OF_SHAPES][NUMBER_OF_ROTATIONS][NUMBER_OF_ROTATIONS];
+};
+
+constexpr PieceTable buildPieceTable() {
+  PieceTable table{};
+
+  for (int shape = 0; shape < NUMBER_OF_SHAPES; shape++) {
+    for (int rotation = 0; rotation < NUMBER_OF_ROTATIONS; rotation++) {
+      int mask = TETRIMINOS[shape][rotation];
+      RotationData &data = table.rotations[shape][rotation];
+      int cellCount = 0;
+
+      data.mask = mask;
+      data.minX = data.minY = NUMBER_OF_ROTATIONS;
+      data.maxX = data.maxY = -1;
+
+      for (int x = 0; x < NUMBER_OF_ROTATIONS; x++) {
+        data.bottoms[x] = -1;
+      }
+
+      for (int y = 0; y < NUMBER_OF_ROTATIONS; y++) {
+        data.rowMasks[y] = (mask >> (12 - 4 * y)) & 0xF;
+        data.slice |= (uint64_t)data.rowMasks[y] << (16 * y);
+
+        for (int x = 0; x < NUMBER_OF_ROTATIONS; x++) {
+          if (mask & (0x8000 >> (y * NUMBER_OF_ROTATIONS + x))) {
+            data.cells[cellCount].x = x;
+            data.cells[cellCount].y = y;
+            cellCount++;
+
+            data.minX = x < data.minX ? x : data.minX;
+            data.maxX = x > data.maxX ? x : data.maxX;
+            data.minY = y < data.minY ? y : data.minY;
+            data.maxY = y > data.maxY ? y : data.maxY;
+            data.bottoms[x] = y;
+          }
+        }
+      }
+    }
+
+    // Compare the squares of each rotation with the ones before it. They are listed in the same
+    // order, so if the first squares are moved by some offset all the others must be too.
+    for (int rotation = 0; rotation < NUMBER_OF_ROTATIONS; rotation++) {
+      RotationData &data = table.rotations[shape][rotation];
+      data.sameAs = rotation;
+
+      for (int other = 0; other < rotation; other++) {
+        const RotationData &otherData = table.rotations[shape][other];
+        int dx = otherData.cells[0].x - data.cells[0].x;
+        int dy = otherData.cells[0].y - data.cells[0].y;
+        bool same = true;
+
+        for (int i = 0; i < 4; i++) {
+          same = same && otherData.cells[i].x - data.cells[i].x == dx &&
+                 otherData.cells[i].y - data.cells[i].y == dy;
+        }
+
+        if (same) {
+          data.sameAs = other;
+          data.sameAsX = -dx;
+          data.sameAsY = -dy;
+          break;
+        }
+      }
+    }
+
+    // Rotating right from r uses the kicks at 2 * r, rotating left from r the ones at 2 * r - 1
+    const KickData *kickData = shape == TETRIMINO_I ? WALL_KICKS_I : WALL_KICKS;
+    for (int from = 0; from < NUMBER_OF_ROTATIONS; from++) {
+      table.kicks[shape][from][(from + 1) % NUMBER_OF_ROTATIONS] = &kickData[2 * from];
+      table.kicks[shape][from][(from + 3) % NUMBER_OF_ROTATIONS] = &kickData[(2 * from + 7) % 8];
+    }
+  }
+
+  return table;
+}
+
+inline constexpr PieceTable PIECE_TABLE = buildPieceTable();
@@ -1,6 +1,12 @@
 #pragma once
 
-#define FPS 60
+// Game logic updates per second. Rendering is not tied to it, frames are drawn as fast as the
+// display allows and the game catches up with as many ticks as needed.
+#define TICK_RATE 60
+
+// Longest frame time the game will try to catch up with. After a longer hitch (e.g. dragging the
+// window) the game just slows down instead of running dozens of ticks at once.
+#define MAX_FRAME_TIME 0.25f
 
 #define WINDOW_W 600
 #define WINDOW_H 600
@@ -8,3 +14,7 @@
 #define WINDOW_MARGIN 20
 
 #define LINE_HEIGHT 15
+
+// Where every game played is recorded, and how far LEFT / RIGHT jump when watching one
+#define REPLAYS_DIR "replays"
+#define REPLAY_SEEK_SECONDS 10
@@ -0,0 +1,31 @@
+#include "hud_label.h"
+
+HudLabel::HudLabel(const char *format, int fontSize, Color color, long maxValue)
+    : format(format), fontSize(fontSize), color(color) {
+  int width = MeasureText(TextFormat(format, maxValue), fontSize);
+  texture = LoadRenderTexture(width, fontSize);
+}
+
+void HudLabel::set(long newValue) {
+  if (valid && newValue == value) {
+    return;
+  }
+
+  BeginTextureMode(texture);
+  ClearBackground(BLANK);
+  DrawText(TextFormat(format, newValue), 0, 0, fontSize, color);
+  EndTextureMode();
+
+  value = newValue;
+  valid = true;
+}
+
+void HudLabel::Draw(int x, int y) const {
+  if (!valid) {
+    return;
+  }
+
+  // Render textures are upside down, hence the negative height
+  Rectangle source = {0, 0, (float)texture.texture.width, -(float)texture.texture.height};
+  DrawTextureRec(texture.texture, source, {(float)x, (float)y}, WHITE);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <raylib.h>
+
+// A line of HUD text showing a number, like "Score: 1200". The text is drawn once into a texture
+// when the number changes, and every frame just draws that texture: laying out the glyphs again
+// each frame for a score that changes a few times a minute is wasted work.
+class HudLabel {
+private:
+  const char *format; // printf format with a single %ld
+  int fontSize;
+  Color color;
+  RenderTexture2D texture;
+  long value = 0;
+  bool valid = false;
+
+public:
+  // The texture is made wide enough for the format with maxValue in it
+  HudLabel(const char *format, int fontSize, Color color, long maxValue);
+  ~HudLabel() { UnloadRenderTexture(texture); }
+
+  HudLabel(const HudLabel &) = delete;
+  HudLabel &operator=(const HudLabel &) = delete;
+
+  // Draws the text again if the value changed. It draws to a texture, so it has to be called
+  // outside of BeginDrawing / BeginTextureMode.
+  void set(long newValue);
+
+  void Draw(int x, int y) const;
+};
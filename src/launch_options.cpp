@@ -0,0 +1,37 @@
+#include "launch_options.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+LaunchOptions &getLaunchOptions() {
+  static LaunchOptions options;
+  return options;
+}
+
+void parseLaunchOptions(int argc, char **argv) {
+  LaunchOptions &options = getLaunchOptions();
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--tick-rate") == 0 && i + 1 < argc) {
+      options.tickRate = atoi(argv[++i]);
+
+      if (options.tickRate <= 0) {
+        std::cerr << "Invalid tick rate, using " << TICK_RATE << std::endl;
+        options.tickRate = TICK_RATE;
+      }
+    } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+      options.replayPath = argv[++i];
+    } else if (strcmp(argv[i], "--bot") == 0) {
+      options.bot = true;
+    } else if (strcmp(argv[i], "--bot-weights") == 0 && i + 1 < argc) {
+      options.bot = true;
+      options.botWeightsPath = argv[++i];
+    } else if (strcmp(argv[i], "--no-record") == 0) {
+      options.record = false;
+    } else if (strcmp(argv[i], "--startup-trace") == 0 && i + 1 < argc) {
+      options.startupTracePath = argv[++i];
+    } else {
+      std::cerr << "Unknown option: " << argv[i] << std::endl;
+    }
+  }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "globals.h"
+#include <string>
+
+// Settings that can be changed from the command line
+struct LaunchOptions {
+  int tickRate = TICK_RATE; // --tick-rate <ticks per second>
+  std::string replayPath;   // --replay <file>, watch a recorded game instead of playing
+  bool bot = false;         // --bot, let the computer play
+  std::string botWeightsPath; // --bot-weights <file>, the bot's weights (implies --bot)
+  bool record = true;         // --no-record, don't save the games to REPLAYS_DIR
+  std::string startupTracePath; // --startup-trace <file>, write how startup went as a Chrome trace
+};
+
+// Options for this run of the game. They are parsed once at startup by parseLaunchOptions.
+LaunchOptions &getLaunchOptions();
+
+void parseLaunchOptions(int argc, char **argv);
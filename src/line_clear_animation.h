@@ -1,12 +1,12 @@
 #pragma once
 
+#include "core/mino_grid.h"
 #include <raylib.h>
-#include <vector>
 
 enum class AnimationState { NONE, FLASHING, CLEARING, DROPPING };
 
 struct LineClearAnimation {
-  std::vector<int> rowsToClear;                // Rows that need to be cleared
+  RowList rowsToClear;                         // Rows that need to be cleared
   AnimationState state = AnimationState::NONE; // Current state of the animation
   float timer = 0.0f;                          // Timer for animation progress
   float flashDuration = 0.3f;                  // How long lines flash before clearing
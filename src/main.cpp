@@ -1,45 +1,97 @@
+#include "asset_loader.h"
+#include "asset_queue.h"
 #include "globals.h"
+#include "launch_options.h"
 #include "scene_manager.h"
-#include "utils.h"
+#include "sound_manager.h"
+#include "startup_trace.h"
+#include "texture_manager.h"
+#include <algorithm>
 #include <iostream>
-#include <physfs.h>
 #include <raylib.h>
 
 using namespace std;
 
-int main(void) {
+int main(int argc, char **argv) {
+  // Startup is timed from here to the first frame on screen
+  StartupTrace &startupTrace = StartupTrace::getInstance();
+
   const int screenWidth = WINDOW_W;
   const int screenHeight = WINDOW_H;
 
+  parseLaunchOptions(argc, argv);
+
   SetTraceLogLevel(LOG_WARNING | LOG_ERROR);
 
-  InitWindow(screenWidth, screenHeight, "Riktris");
-  InitAudioDevice(); // Initialize audio device
+  // Read the zip files and make them available for data loading. The first scene's assets are read
+  // and decoded in the background while the window and the audio device start.
+  {
+    StartupSpan span("mountAssets");
+    mountAssets();
+  }
 
-  SetTargetFPS(FPS); // Set our game to run at 60 frames-per-second
+  // The singletons are created here rather than on first use, so each one has its own span
+  {
+    StartupSpan span("create SceneManager");
+    SceneManager::getInstance();
+  }
+  {
+    StartupSpan span("create TextureManager");
+    TextureManager::getInstance();
+  }
+  {
+    StartupSpan span("create SoundManager");
+    SoundManager::getInstance();
+  }
 
-  int framesCounter = 0;
+  SceneManager &sceneManager = SceneManager::getInstance();
+  {
+    StartupSpan span("prefetch first scene");
+    sceneManager.prefetchScene(sceneManager.getTopSceneId());
+  }
 
-  // Read the zip files and make them available for data loading.
-  must_init(PHYSFS_init(NULL), "PHYSFS engine");
-  must_init(PHYSFS_mount("gfx.dat", NULL, 1), "gfx zip file");
-  must_init(PHYSFS_mount("sfx.dat", NULL, 1), "sfx zip file");
-  must_init(PHYSFS_mount("misc.dat", NULL, 1), "dat zip file");
+  // Frames are drawn at the display refresh rate, the game logic runs at its own fixed rate
+  SetConfigFlags(FLAG_VSYNC_HINT);
+  {
+    StartupSpan span("InitWindow");
+    InitWindow(screenWidth, screenHeight, "Riktris");
+  }
+  {
+    StartupSpan span("InitAudioDevice");
+    InitAudioDevice(); // Initialize audio device
+  }
 
-  SceneManager &sceneManager = SceneManager::getInstance();
+  int framesCounter = 0;
 
   std::cout << "Starting with scene: " << sceneManager.getCurrentSceneName() << std::endl;
 
+  const float tickTime = 1.0f / getLaunchOptions().tickRate;
+  float accumulator = 0.0f;
+
   // Main game loop, detects window close of ESC key
   while (!WindowShouldClose()) {
     framesCounter++;
-    sceneManager.Update();
+    AssetQueue::getInstance().upload(ASSET_UPLOAD_BUDGET_MS);
+    sceneManager.PollInput();
+
+    // Run as many fixed ticks as fit in the time that passed since the last frame. Whatever is
+    // left is carried over to the next frame.
+    accumulator += std::min(GetFrameTime(), MAX_FRAME_TIME);
+
+    while (accumulator >= tickTime) {
+      sceneManager.Update();
+      accumulator -= tickTime;
+    }
 
     BeginDrawing();
 
-    sceneManager.Draw();
+    sceneManager.Draw(accumulator / tickTime);
 
     EndDrawing();
+
+    if (framesCounter == 1) {
+      startupTrace.finish(getLaunchOptions().startupTracePath);
+    }
   }
 
   CloseWindow(); // Close window and OpenGL context
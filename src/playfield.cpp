@@ -1,254 +1,117 @@
 #include "playfield.h"
 #include "line_clear_animation.h"
-#include "mino_grid.h"
-#include "tetrimino.h"
-#include <iostream>
+#include "texture_manager.h"
+#include <algorithm>
 #include <raylib.h>
 
-void Playfield::Update() {
-  if (!clearAnimation.isActive)
-    return;
-
-  clearAnimation.timer += GetFrameTime();
+void Playfield::Update(const Game &game) {
+  if (!game.isClearingLines()) {
+    clearAnimation.isActive = false;
+    clearAnimation.state = AnimationState::NONE;
+  } else {
+    if (!clearAnimation.isActive) {
+      clearAnimation.rowsToClear = game.getClearingRows();
+      clearAnimation.state = AnimationState::FLASHING;
+      clearAnimation.isActive = true;
+    }
 
-  switch (clearAnimation.state) {
-  case AnimationState::FLASHING: {
+    // The game keeps the time of the line clear, the animation just follows it
     float flashInterval = clearAnimation.flashDuration / clearAnimation.maxFlashes;
+    clearAnimation.timer = game.ticksToSeconds(game.getLineClearTimer());
+    clearAnimation.flashCount = (int)(clearAnimation.timer / flashInterval);
+  }
 
-    if (clearAnimation.timer >= flashInterval) {
-      clearAnimation.flashCount++;
-      clearAnimation.timer = 0.0f;
+  if (!stackValid || !(game.getGrid() == stackGrid) || isClearingShown() != stackClearingShown) {
+    renderStack(game.getGrid());
+  }
+}
 
-      if (clearAnimation.flashCount >= clearAnimation.maxFlashes) {
-        // Move to clearing phase
-        clearAnimation.state = AnimationState::CLEARING;
-        clearAnimation.timer = 0.0f;
+// Whether the rows being cleared are visible right now, they flash on and off
+bool Playfield::isClearingShown() const {
+  return !clearAnimation.isActive ||
+         (clearAnimation.flashCount % 2 == 0 && clearAnimation.state == AnimationState::FLASHING);
+}
 
-        // TODO: to remove after other animations are implemented
-        clearAnimation.isActive = false;
-        clearAnimation.state = AnimationState::NONE;
-        executeLineClear();
-      }
-    }
-    break;
-  }
-  case AnimationState::CLEARING: {
-    // if (clearAnimation.timer >= clearAnimation.clearDuration) {
-    //   // Actually remove the lines from the grid
-    //   executeLineClear();
-    //
-    //   // Move to dropping phase
-    //   clearAnimation.state = AnimationState::DROPPING;
-    //   clearAnimation.timer = 0.0f;
-    //
-    //   // Calculate how far each row needs to drop
-    //   int linesCleared = clearAnimation.rowsToClear.size();
-    //   for (int row = 0; row < GRID_HEIGHT; row++) {
-    //     int dropDistance = 0;
-    //     for (int clearedRow : clearAnimation.rowsToClear) {
-    //       if (clearedRow < row) {
-    //         dropDistance++;
-    //       }
-    //     }
-    //     rowDropOffsets[row] = -dropDistance * (MINO_W + 1); // Negative = up
-    //   }
-    // }
-    break;
-  }
+void Playfield::renderStack(const MinoGrid &grid) {
+  BeginTextureMode(stackTexture);
+  // The scene is drawn on black, so the texture starts out the same and looks exactly like drawing
+  // straight to the screen (even where the background is see-through)
+  ClearBackground(BLACK);
+  drawStack(grid, {0, 0}, {PLAYFIELD_PADDING_X, PLAYFIELD_PADDING_Y});
+  EndTextureMode();
+
+  stackGrid = grid;
+  stackClearingShown = isClearingShown();
+  stackValid = true;
+}
 
-  case AnimationState::DROPPING: {
-    // // Animate rows dropping down smoothly
-    // float progress = clearAnimation.timer / clearAnimation.dropDuration;
-    // progress = std::min(1.0f, progress);
-    //
-    // float easedProgress = 1.0f - (1.0f - progress) * (1.0f - progress); // Ease out
-    //
-    // // Update drop offsets
-    // int linesCleared = clearAnimation.rowsToClear.size();
-    // for (int row = 0; row < GRID_HEIGHT; row++) {
-    //   int dropDistance = 0;
-    //   for (int clearedRow : clearAnimation.rowsToClear) {
-    //     if (row < clearedRow) {
-    //       dropDistance++;
-    //     }
-    //   }
-    //
-    //   if (dropDistance > 0) {
-    //     float targetOffset = dropDistance * (MINO_W + 1);
-    //     rowDropOffsets[row] = -targetOffset + (targetOffset * easedProgress);
-    //   }
-    // }
-    //
-    // if (progress >= 1.0f) {
-    //   // Animation complete
-    //   clearAnimation.isActive = false;
-    //   clearAnimation.state = AnimationState::NONE;
-    //   std::fill(rowDropOffsets.begin(), rowDropOffsets.end(), 0.0f);
-    // }
-    break;
+void Playfield::Draw(const MinoGrid &grid) {
+  // Before the first Update there is nothing in the texture yet
+  if (!stackValid) {
+    drawStack(grid, position, drawStart);
+    return;
   }
 
-  case AnimationState::NONE:
-  default:
-    break;
-  }
+  // Render textures are upside down, hence the negative height
+  Rectangle source = {0, 0, (float)stackTexture.texture.width, -(float)stackTexture.texture.height};
+  DrawTextureRec(stackTexture.texture, source, position, WHITE);
 }
 
-void Playfield::Draw() {
-  DrawTexture(playfieldTexture, position.x, position.y, WHITE);
+// Draws the background at origin and the grid from start
+void Playfield::drawStack(const MinoGrid &grid, Vector2 origin, Vector2 start) {
+  DrawTexture(TextureManager::getInstance().getTexture(playfieldTexture), origin.x, origin.y,
+              WHITE);
 
-  grid.drawAnimated(drawStart.x, drawStart.y, clearAnimation);
-  // if (clearAnimation.isActive) {
-  // } else {
-  //   grid.Draw(drawStart.x, drawStart.y);
-  // }
+  drawGrid(grid, start);
 }
 
-// void Playfield::drawWithAnimation() {
-//
-//   const auto &rowsToClear = clearAnimation.rowsToClear;
-//
-//   switch (clearAnimation.state) {
-//   case AnimationState::FLASHING: {
-//     // Alternate the visibility of the clearing rows
-//     for (int row = 0; row < GRID_HEIGHT; ++row) {
-//       bool isClearing = std::find(rowsToClear.begin(), rowsToClear.end(), row) !=
-//       rowsToClear.end(); if (isClearing) {
-//         // Flash: show/hide based on even/odd flashCount
-//         if (clearAnimation.flashCount % 2 == 0) {
-//           grid.DrawRow(row, drawStart.x, drawStart.y + row * (MINO_W + 1));
-//         }
-//       } else {
-//         grid.DrawRow(row, drawStart.x, drawStart.y + row * (MINO_W + 1));
-//       }
-//     }
-//     break;
-//   }
-//   case AnimationState::CLEARING: {
-//     // Draw all rows normally (or optionally fade out the clearing rows)
-//     for (int row = 0; row < GRID_HEIGHT; ++row) {
-//       grid.DrawRow(row, drawStart.x, drawStart.y + row * (MINO_W + 1));
-//     }
-//     break;
-//   }
-//   case AnimationState::DROPPING: {
-//     // Shift rows visually by rowDropOffsets[row]
-//     for (int row = 0; row < GRID_HEIGHT; ++row) {
-//       float offset = rowDropOffsets[row];
-//       grid.DrawRow(row, drawStart.x, drawStart.y + row * (MINO_W + 1) + offset);
-//     }
-//     break;
-//   }
-//   default:
-//     // Fallback: draw grid as normal
-//     grid.Draw(drawStart.x, drawStart.y);
-//     break;
-//   }
-// }
-
-void Playfield::executeLineClear() { grid.removeCompletedRows(); }
-
-bool Playfield::TetriminoOverlapping(Tetrimino *tetrimino) const {
-  int tetCol = tetrimino->getCol();
-  int tetRow = tetrimino->getRow();
-
-  for (int x = 0; x < NUMBER_OF_ROTATIONS; x++) {
-    for (int y = 0; y < NUMBER_OF_ROTATIONS; y++) {
-      if (tetrimino->isFilled(x, y)) {
-        // The square is overlapping an existing square in the playfield.
-        if (grid.matrix[tetCol + x][tetRow + y]) {
-          return true;
-        }
-        // The square is outside of the playfield!
-        if ((tetCol + x) > ((int)GRID_WIDTH - 1) || (tetRow + y) > ((int)GRID_HEIGHT - 1) ||
-            (tetCol + x) < 0) {
-          return true;
-        }
-      }
-    }
-  }
-
-  return false;
+// Draws one square from the mino atlas: the frame is the shape, plus NUMBER_OF_SHAPES for a ghost
+void Playfield::drawMino(int frame, float x, float y, Color tint) {
+  DrawTextureRec(minoAtlas->texture, minoAtlas->frames[frame], {x, y}, tint);
 }
 
-// Check if the tetrimino is touching the left margin of the playfield or exiting squares in the
-// grid matrix. If it is, return true.
-bool Playfield::isTouchingLeft(Tetrimino *tetrimino) const {
-  for (int x = 0; x < NUMBER_OF_ROTATIONS; x++) {
-    for (int y = 0; y < NUMBER_OF_ROTATIONS; y++) {
-      if (tetrimino->isFilled(x, y)) {
-        // Touching the left wall
-        if (tetrimino->getCol() + x <= 0) {
-          return true;
-        }
-
-        // Touching existing squares in the field matrix
-        if (grid.matrix[tetrimino->getCol() + x - 1][tetrimino->getRow() + y]) {
-          return true;
-        }
-      }
+// Draws the minos already in place in the grid, flashing the rows that are being cleared.
+void Playfield::drawGrid(const MinoGrid &grid, Vector2 start) {
+  for (int y = 0; y < GRID_HEIGHT; y++) {
+    if (grid.getRowMask(y) == ROW_EMPTY) {
+      continue;
     }
-  }
-  return false;
-}
 
-// Check if the tetrimino is touching the right margin of the playfield or exiting squares in the
-// grid matrix. If it is, return true.
-bool Playfield::isTouchingRight(Tetrimino *tetrimino) const {
-  for (int x = 0; x < NUMBER_OF_ROTATIONS; x++) {
-    for (int y = 0; y < NUMBER_OF_ROTATIONS; y++) {
-      if (tetrimino->isFilled(x, y)) {
-        // Touching the right wall
-        if (tetrimino->getCol() + x >= GRID_WIDTH - 1) {
-          return true;
-        }
-
-        // Touching existing squares in the field matrix
-        if (grid.matrix[tetrimino->getCol() + x + 1][tetrimino->getRow() + y]) {
-          return true;
-        }
-      }
+    bool clearing = clearAnimation.isActive && clearAnimation.rowsToClear.contains(y);
+
+    // If the animation is flashing, we might want to skip drawing this row
+    if (clearing && !isClearingShown()) {
+      continue;
     }
-  }
-  return false;
-}
 
-// Check if the tetrimino is touching the bottom margin of the playfield or exiting squares in the
-// grid matrix. If it is, return true.
-bool Playfield::isTouchingDown(Tetrimino *tetrimino) const {
-  for (int x = 0; x < NUMBER_OF_ROTATIONS; x++) {
-    for (int y = 0; y < NUMBER_OF_ROTATIONS; y++) {
-      if (tetrimino->isFilled(x, y)) {
-        // Touching the bottom wall
-        if (tetrimino->getRow() + y >= GRID_HEIGHT - 1) {
-          return true;
-        }
-
-        // Touching existing squares in the field matrix
-        if (grid.matrix[tetrimino->getCol() + x][tetrimino->getRow() + y + 1]) {
-          return true;
-        }
+    for (int x = 0; x < GRID_WIDTH; x++) {
+      if (grid.getCell(x, y)) {
+        int minoType = grid.getCell(x, y) - 1; // Adjust for zero-based index
+
+        int posX = x * (MINO_W + 1);
+        int posY = y * (MINO_W + 1);
+
+        // Draw the mino by getting the right mino gfx. If we have 1 in the
+        // matrix then the mino is zero, since TETRIMINO_TYPE starts at 0.
+        drawMino(minoType, posX + start.x, posY + start.y, WHITE);
       }
     }
   }
-  return false;
 }
 
-void Playfield::startLineClearAnimation(const std::vector<int> &rows) {
-  if (rows.empty()) {
-    return;
-  }
-
-  clearAnimation.rowsToClear = rows;
-  clearAnimation.state = AnimationState::FLASHING;
-  clearAnimation.timer = 0.0f;
-  clearAnimation.flashCount = 0;
-  clearAnimation.isActive = true;
+void Playfield::drawTetrimino(const Tetrimino &tetrimino, MINO_DRAW_TYPE drawType, Vector2 offset,
+                              float alpha) {
+  int tx, ty;
 
-  // Backup current grid state to tempGrid
-  tempGrid = grid;
+  for (const MinoOffset &cell : tetrimino.getRotationData().cells) {
+    tx = (cell.x + tetrimino.getCol() + offset.x) * (MINO_W + 1) + drawStart.x;
+    ty = (cell.y + tetrimino.getRow() + offset.y) * (MINO_W + 1) + drawStart.y;
 
-  // Initialize row drop offsets
-  rowDropOffsets.clear();
-  rowDropOffsets.resize(GRID_HEIGHT, 0.0f);
+    if (drawType == MINO_BLOCK) {
+      drawMino(tetrimino.getShape(), tx, ty, Fade(WHITE, alpha));
+    } else {
+      // Semi-transparent ghost
+      drawMino(NUMBER_OF_SHAPES + tetrimino.getShape(), tx, ty, Fade(WHITE, 0.5f * alpha));
+    }
+  }
 }
@@ -1,11 +1,14 @@
 #pragma once
 
+#include "core/game.h"
+#include "core/mino_grid.h"
+#include "core/tetrimino.h"
 #include "globals.h"
 #include "line_clear_animation.h"
-#include "mino_grid.h"
-#include "tetrimino.h"
+#include "texture_manager.h"
 #include "utils.h"
 #include <raylib.h>
+#include <string>
 #include <vector>
 
 // The padding in pixels around the playfield texture (basically the borders of
@@ -13,14 +16,40 @@
 #define PLAYFIELD_PADDING_X 6u
 #define PLAYFIELD_PADDING_Y 7u
 
+// TODO: we can take this from the texture
+// Pixel width of a single mino in the grid (a square that forms the tetriminos)
+#define MINO_W 25
+
+#define PLAYFIELD_TEXTURE "playfield.png"
+
+// Tetrimino names for loading textures
+inline const std::vector<std::string> MINO_NAMES = {"t", "s", "z", "i", "j", "l", "o"};
+
+#define MINO_ATLAS "minos"
+
+// The images of the mino atlas: every shape, then the ghost of every shape
+inline std::vector<std::string> getMinoFiles() {
+  std::vector<std::string> minoFiles;
+  for (int shape = 0; shape < NUMBER_OF_SHAPES; shape++) {
+    minoFiles.push_back("mino_" + MINO_NAMES[shape] + ".png");
+  }
+  for (int shape = 0; shape < NUMBER_OF_SHAPES; shape++) {
+    minoFiles.push_back("mino_ghost_" + MINO_NAMES[shape] + ".png");
+  }
+  return minoFiles;
+}
+
+typedef enum MINO_DRAW_TYPE { MINO_BLOCK, MINO_GHOST } MINO_DRAW_TYPE;
+
+// Draws the playfield: its background, the minos already in the grid and the tetriminos moving
+// inside of it. All the rules live in Game, this only knows how to show them.
 class Playfield {
 private:
   LineClearAnimation clearAnimation;
-  Texture2D playfieldTexture;
-  MinoGrid grid;
-
-  MinoGrid tempGrid;                 // for line clearing animation
-  std::vector<float> rowDropOffsets; // Offsets for dropping rows during animation
+  TextureHandle playfieldTexture;
+  // The minos of every shape followed by their ghosts, all in one texture so the whole board is
+  // drawn in a single batch
+  const TextureAtlas *minoAtlas;
 
   // The x,y position of the playfield texture in the window.
   Vector2 position;
@@ -28,41 +57,52 @@ private:
   // Where to start drawing the tetriminos in the playfield texture.
   Vector2 drawStart;
 
+  // The background and the locked minos, which only change when a piece locks and during line
+  // clears. They are drawn here when they change, and every frame just draws this one texture.
+  RenderTexture2D stackTexture;
+  MinoGrid stackGrid;             // The grid drawn in stackTexture
+  bool stackClearingShown = true; // Whether the rows being cleared were drawn in it
+  bool stackValid = false;
+
+  bool isClearingShown() const;
+  void renderStack(const MinoGrid &grid);
+  void drawStack(const MinoGrid &grid, Vector2 origin, Vector2 start);
+  void drawGrid(const MinoGrid &grid, Vector2 start);
+  void drawMino(int frame, float x, float y, Color tint);
+
 public:
   Playfield() {
     // Load necessary textures
-    playfieldTexture = LoadTexture("data/gfx/playfield.png");
+    playfieldTexture = TextureManager::getInstance().loadTexture(PLAYFIELD_TEXTURE);
+    const Texture2D &texture = TextureManager::getInstance().getTexture(playfieldTexture);
 
     // Center the playfield texture in the window
-    position = {(float)GetScreenWidth() / 2 - (float)playfieldTexture.width / 2,
-                (float)GetScreenHeight() / 2 - (float)playfieldTexture.height / 2};
+    position = {(float)GetScreenWidth() / 2 - (float)texture.width / 2,
+                (float)GetScreenHeight() / 2 - (float)texture.height / 2};
 
     drawStart = {position.x + PLAYFIELD_PADDING_X, position.y + PLAYFIELD_PADDING_Y};
-  }
 
-  ~Playfield() { UnloadTexture(playfieldTexture); }
+    minoAtlas = &TextureManager::getInstance().getAtlas(MINO_ATLAS, getMinoFiles());
 
-  void Update();
+    stackTexture = LoadRenderTexture(texture.width, texture.height);
+  }
 
-  // Drawing with animation support
-  void Draw();
-  void drawFlashingRows();
-  void drawDroppingRows();
+  ~Playfield() { UnloadRenderTexture(stackTexture); }
 
-  Vector2 getDrawStart() const { return drawStart; }
-  bool isTouchingLeft(Tetrimino *mino) const;
-  bool isTouchingRight(Tetrimino *mino) const;
-  bool isTouchingDown(Tetrimino *mino) const;
-  bool TetriminoOverlapping(Tetrimino *tetrimino) const;
-  std::vector<int> getCompletedRows() const { return grid.getCompletedRows(); }
+  Playfield(const Playfield &) = delete;
+  Playfield &operator=(const Playfield &) = delete;
 
-  void RotateCurrentTetrimino();
-  void addTetriminoToGrid(Tetrimino *tetrimino) { grid.addTetrimino(tetrimino); }
+  // Follows the line clears of the game to animate them, and redraws the stack if it changed. It
+  // draws to a texture, so it has to be called outside of BeginDrawing / BeginTextureMode.
+  void Update(const Game &game);
 
-  // Modified line clearing
-  void executeLineClear();
+  // Drawing with animation support
+  void Draw(const MinoGrid &grid);
+  // The offset (in squares) moves the tetrimino away from its position in the grid, which is used
+  // to draw it in between two positions.
+  void drawTetrimino(const Tetrimino &tetrimino, MINO_DRAW_TYPE drawType, Vector2 offset = {0, 0},
+                     float alpha = 1.0f);
 
-  // Animation methods
-  void startLineClearAnimation(const std::vector<int> &rows);
+  Vector2 getDrawStart() const { return drawStart; }
   bool isAnimationRunning() const { return clearAnimation.isActive; }
 };
@@ -1,13 +1,16 @@
 #include "scene_manager.h"
 #include "scenes/gameplay_scene.h"
+#include "startup_trace.h"
+#include <algorithm>
 #include <iostream>
 
 SceneManager::SceneManager() {
   // Initialize all scenes
   scenes.resize(6); // Updated size for new scenes
+  sceneStack.reserve(scenes.size());
 
   // Start with LOGO scene
-  sceneStack.push(GAMEPLAY_SCENE);
+  sceneStack.push_back(GAMEPLAY_SCENE);
 }
 
 SceneManager &SceneManager::getInstance() {
@@ -47,9 +50,27 @@ std::unique_ptr<GameScene> SceneManager::createScene(GameSceneId id) {
   }
 }
 
+AssetManifest SceneManager::getManifest(GameSceneId id) {
+  // Every scene is the gameplay one for now
+  return GameplayScene::getManifest();
+}
+
+void SceneManager::prefetchScene(GameSceneId id) {
+  if (id >= 0 && id < scenes.size() && !scenes[id]) {
+    AssetQueue::getInstance().request(getManifest(id));
+  }
+}
+
 // Get scene with lazy initialization using factory
 std::unique_ptr<GameScene> &SceneManager::getScene(GameSceneId id) {
   if (!scenes[id]) {
+    // Whatever was prefetched is uploaded first, so the scene finds its assets already loaded
+    {
+      StartupSpan span("wait for prefetched assets");
+      AssetQueue::getInstance().finish();
+    }
+
+    StartupSpan span("create scene " + std::to_string(id));
     scenes[id] = createScene(id);
   }
   return scenes[id];
@@ -59,7 +80,7 @@ std::unique_ptr<GameScene> &SceneManager::getScene(GameSceneId id) {
 void SceneManager::switchTo(GameSceneId id) {
   if (id >= 0 && id < scenes.size()) {
     clearStack();
-    sceneStack.push(id);
+    sceneStack.push_back(id);
     auto &scene = getScene(id);
 
     if (scene) {
@@ -70,7 +91,7 @@ void SceneManager::switchTo(GameSceneId id) {
 
 void SceneManager::pushScene(GameSceneId id) {
   if (id >= 0 && id < scenes.size()) {
-    sceneStack.push(id);
+    sceneStack.push_back(id);
     auto &scene = getScene(id);
     if (scene) {
       std::cout << "Pushed scene: " << scenes[id]->getName()
@@ -81,8 +102,8 @@ void SceneManager::pushScene(GameSceneId id) {
 
 void SceneManager::popScene() {
   if (sceneStack.size() > 1) { // Keep at least one scene
-    GameSceneId poppedScene = sceneStack.top();
-    sceneStack.pop();
+    GameSceneId poppedScene = sceneStack.back();
+    sceneStack.pop_back();
     auto &scene = getScene(poppedScene);
     if (scene) {
       std::cout << "Popped scene: " << scenes[poppedScene]->getName()
@@ -91,16 +112,13 @@ void SceneManager::popScene() {
   }
 }
 
-void SceneManager::clearStack() {
-  while (!sceneStack.empty()) {
-    sceneStack.pop();
-  }
-}
+void SceneManager::clearStack() { sceneStack.clear(); }
 
 // Optional: Method to preload specific scenes
 void SceneManager::preloadScene(GameSceneId id) {
   if (id >= 0 && id < scenes.size() && !scenes[id]) {
     std::cout << "Preloading scene: " << id << std::endl;
+    AssetQueue::getInstance().finish();
     scenes[id] = createScene(id);
   }
 }
@@ -109,16 +127,7 @@ void SceneManager::preloadScene(GameSceneId id) {
 void SceneManager::unloadScene(GameSceneId id) {
   if (id >= 0 && id < scenes.size() && scenes[id]) {
     // Make sure scene isn't currently in the stack
-    std::stack<GameSceneId> tempStack = sceneStack;
-    bool inUse = false;
-
-    while (!tempStack.empty()) {
-      if (tempStack.top() == id) {
-        inUse = true;
-        break;
-      }
-      tempStack.pop();
-    }
+    bool inUse = std::find(sceneStack.begin(), sceneStack.end(), id) != sceneStack.end();
 
     if (!inUse) {
       std::cout << "Unloading scene: " << scenes[id]->getName() << std::endl;
@@ -129,10 +138,20 @@ void SceneManager::unloadScene(GameSceneId id) {
   }
 }
 
+void SceneManager::PollInput() {
+  // Only the top scene (the active one) reads input
+  if (!sceneStack.empty()) {
+    auto &scene = getScene(sceneStack.back());
+    if (scene) {
+      scene->PollInput();
+    }
+  }
+}
+
 void SceneManager::Update() {
   // Only update the top scene (the active one)
   if (!sceneStack.empty()) {
-    GameSceneId currentSceneId = sceneStack.top();
+    GameSceneId currentSceneId = sceneStack.back();
     if (currentSceneId < scenes.size()) {
       auto &scene = getScene(currentSceneId);
       if (scene) {
@@ -142,33 +161,19 @@ void SceneManager::Update() {
   }
 }
 
-void SceneManager::Draw() {
-  if (sceneStack.empty())
-    return;
-
-  // Create a temporary stack to iterate from bottom to top
-  std::stack<GameSceneId> tempStack;
-  std::stack<GameSceneId> originalStack = sceneStack; // Copy the stack
-
-  // Move all elements to temp stack (reverses order)
-  while (!originalStack.empty()) {
-    tempStack.push(originalStack.top());
-    originalStack.pop();
-  }
-
+void SceneManager::Draw(float interpolation) {
   // Render from bottom to top
-  while (!tempStack.empty()) {
-    GameSceneId scene = tempStack.top();
-    tempStack.pop();
+  for (size_t i = 0; i < sceneStack.size(); i++) {
+    GameSceneId scene = sceneStack[i];
 
     if (scene < scenes.size()) {
-      scenes[scene]->Draw();
+      scenes[scene]->Draw(interpolation);
     }
   }
 }
 
 GameSceneId SceneManager::getTopSceneId() const {
-  return sceneStack.empty() ? LOGO_SCENE : sceneStack.top();
+  return sceneStack.empty() ? LOGO_SCENE : sceneStack.back();
 }
 
 bool SceneManager::hasActiveScenes() const { return !sceneStack.empty(); }
@@ -1,8 +1,8 @@
 #pragma once
 
+#include "asset_queue.h"
 #include "scenes/game_scene.h"
 #include <memory>
-#include <stack>
 #include <string>
 #include <vector>
 
@@ -18,7 +18,8 @@ typedef enum GameSceneId {
 class SceneManager {
 private:
   std::vector<std::unique_ptr<GameScene>> scenes;
-  std::stack<GameSceneId> sceneStack;
+  // Bottom to top. Room for every scene is reserved up front, pushing never allocates.
+  std::vector<GameSceneId> sceneStack;
 
   // Private constructor for singleton
   SceneManager();
@@ -41,8 +42,9 @@ public:
   void popScene();
   void clearStack();
 
+  void PollInput();
   void Update();
-  void Draw();
+  void Draw(float interpolation);
 
   GameSceneId getTopSceneId() const;
   bool hasActiveScenes() const;
@@ -52,4 +54,9 @@ public:
   std::unique_ptr<GameScene> createScene(GameSceneId id);
   void unloadScene(GameSceneId id);
   void preloadScene(GameSceneId id);
+
+  // The assets the scene needs, and loading them in the background (see AssetQueue) so they are
+  // ready when the scene is created
+  static AssetManifest getManifest(GameSceneId id);
+  void prefetchScene(GameSceneId id);
 };
@@ -10,6 +10,15 @@ public:
   explicit GameScene(const std::string &sceneName) : name(sceneName) {}
   virtual ~GameScene() = default;
   const std::string &getName() const { return name; }
+
+  // Called once per frame, before any ticks. Scenes that read the keyboard during Update should
+  // remember key presses here, otherwise a quick tap between two ticks would be missed.
+  virtual void PollInput() {}
+
+  // Called once per game tick (TICK_RATE times per second)
   virtual void Update() = 0;
-  virtual void Draw() = 0;
+
+  // Called once per frame. The interpolation is how far we are between the last tick and the next
+  // one (0 to 1), to draw things that move smoothly even when there are more frames than ticks.
+  virtual void Draw(float interpolation) = 0;
 };
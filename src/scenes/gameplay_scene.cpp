@@ -1,396 +1,311 @@
 #include "gameplay_scene.h"
+#include "../allocation_counter.h"
+#include "../launch_options.h"
 #include "../sound_manager.h"
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
 #include <iostream>
+#include <random>
 #include <raylib.h>
 
-float leftKeyTimer = 0.0f;
-float rightKeyTimer = 0.0f;
-float downKeyTimer = 0.0f;
-float fallTimer = 0.0f;
-
-const float LOCK_DELAY = 0.5f;        // Time before a tetrimino locks in place
-const float KEY_REPEAT_DELAY = 0.15f; // Initial delay before repeating
-const float KEY_REPEAT_RATE = 0.05f;  // Time between repeats
-
-GameplayScene::GameplayScene(const std::string &name) : GameScene(name) {
-  playfield = new Playfield();
-  tetriminoBag = new TetriminoBag();
-  currentTetrimino = generateTetrimino();
-
-  // Preload the sounds that will be used in the scene
-  SoundManager soundManager = SoundManager::getInstance();
-  soundManager.preloadSound("move_new.wav");
-  soundManager.preloadSound("rotate_new.wav");
-  soundManager.preloadSound("lock.wav");
-}
+#define MOVE_SOUND "move_new.wav"
+#define ROTATE_SOUND "rotate_new.wav"
+#define LOCK_SOUND "soundss.wav"
 
-// Official Tetris speed curve (frames at 60 FPS)
-// Level 1: 48 frames = 0.8 seconds
-// Level 2: 43 frames = ~0.72 seconds
-// etc.
-float GameplayScene::getFallSpeed() {
-  static const float speeds[] = {
-      0.8f,  // Level 1
-      0.72f, // Level 2
-      0.63f, // Level 3
-      0.55f, // Level 4
-      0.47f, // Level 5
-      0.38f, // Level 6
-      0.30f, // Level 7
-      0.22f, // Level 8
-      0.13f, // Level 9
-      0.10f, // Level 10
-      0.08f, // Level 11
-      0.07f, // Level 12
-      0.05f, // Level 13
-      0.04f, // Level 14
-      0.03f, // Level 15
-      0.02f  // Level 16+
-  };
-
-  int levelIndex = std::min(currentLevel - 1, 15); // Cap at level 16
-  return speeds[levelIndex];
-}
+GameplayScene::GameplayScene(const std::string &name)
+    : GameScene(name), game(0, getLaunchOptions().tickRate),
+      scoreLabel("Score: %ld", 15, WHITE, 999999999), levelLabel("Level: %ld", 15, WHITE, 99),
+      linesLabel("Lines: %ld", 15, WHITE, 99999) {
+  if (getLaunchOptions().bot) {
+    BotConfig config;
+    const std::string &weightsPath = getLaunchOptions().botWeightsPath;
 
-void GameplayScene::RotateCurrentTetrimino(ROTATE_DIRECTION direction) {
-  int originalRotation = currentTetrimino->getRotationIndex();
-
-  // Rotate the tetrimino in the current direction, then we need to check if we need to reset the
-  // rotation or if we can keep it.
-  std::cout << "Rotating tetrimino from rotation " << originalRotation << std::endl;
-  currentTetrimino->Rotate(direction);
-
-  // Col and row before the wall kick calculations
-  int origCol = currentTetrimino->getCol();
-  int origRow = currentTetrimino->getRow();
-  bool kickSuccess = false;
-
-  // If the resulting rotation will overlap existing minos or will end up outside of the playfield
-  // then we need to perform a wall kick. This may or may not succeed, depending on where the
-  // tetrimino is. If it doesn't succeed then we assume we can't rotate the tetrimino at all and
-  // put it back to the original rotation.
-  if (playfield->TetriminoOverlapping(currentTetrimino)) {
-    std::cout << "Tetrimino overlapping, attempting wall kick." << std::endl;
-    kickSuccess = WallKick(originalRotation, currentTetrimino->getRotationIndex());
-
-    if (!kickSuccess) {
-      currentTetrimino->setRotation(originalRotation);
-      currentTetrimino->setCol(origCol);
-      currentTetrimino->setRow(origRow);
+    if (!weightsPath.empty() && !loadEvaluatorWeights(weightsPath, config.weights)) {
+      std::cerr << "Could not read the bot weights from " << weightsPath << std::endl;
     }
+    bot = std::make_unique<Bot>(config);
   }
-}
 
-// Try to wall kick a tetrimino. This should be called only if the tetrimino is overlapping existing
-// minos in the playfield or out of bounds. Depending on the rotation being executed different
-// coordinates will be tested for the wall kick.
-//
-// This function will return true if it successfully wall kicked the tetrimino or false otherwise.
-bool GameplayScene::WallKick(int fromRotation, int toRotation) const {
-  // Will store the kick coordinates for the given rotation
-  KickData kicks;
-  KickData *kickData;
-
-  if (currentTetrimino->getShape() == TETRIMINO_I) {
-    kickData = WALL_KICKS_I;
+  if (getLaunchOptions().replayPath.empty()) {
+    startGame();
   } else {
-    kickData = WALL_KICKS;
-  }
-
-  if (fromRotation == 0 && toRotation == 1) {
-    memcpy(kicks, kickData[0], sizeof(kicks));
-  } else if (fromRotation == 1 && toRotation == 0) {
-    memcpy(kicks, kickData[1], sizeof(kicks));
-  } else if (fromRotation == 1 && toRotation == 2) {
-    memcpy(kicks, kickData[2], sizeof(kicks));
-  } else if (fromRotation == 2 && toRotation == 1) {
-    memcpy(kicks, kickData[3], sizeof(kicks));
-  } else if (fromRotation == 2 && toRotation == 3) {
-    memcpy(kicks, kickData[4], sizeof(kicks));
-  } else if (fromRotation == 3 && toRotation == 2) {
-    memcpy(kicks, kickData[5], sizeof(kicks));
-  } else if (fromRotation == 3 && toRotation == 0) {
-    memcpy(kicks, kickData[6], sizeof(kicks));
-  } else if (fromRotation == 0 && toRotation == 3) {
-    memcpy(kicks, kickData[7], sizeof(kicks));
+    startReplay(getLaunchOptions().replayPath);
   }
 
-  int origCol = currentTetrimino->getCol();
-  int origRow = currentTetrimino->getRow();
-
-  // Tries wall kicks until we're done
-  for (int i = 0; i < NUMBER_OF_ROTATIONS; i++) {
-    currentTetrimino->setCol(origCol + kicks[i][0]);
-    currentTetrimino->setRow(origRow + kicks[i][1]);
+  // Load the sounds that will be used in the scene
+  SoundManager &soundManager = SoundManager::getInstance();
+  moveSound = soundManager.loadSound(MOVE_SOUND);
+  rotateSound = soundManager.loadSound(ROTATE_SOUND);
+  lockSound = soundManager.loadSound(LOCK_SOUND);
+}
 
-    if (!playfield->TetriminoOverlapping(currentTetrimino)) {
-      return true;
-    }
+GameplayScene::~GameplayScene() {
+  if (recorder.isRecording()) {
+    recorder.finish(game);
   }
+}
 
-  // We couldn't wall kick!
-  return false;
+AssetManifest GameplayScene::getManifest() {
+  AssetManifest manifest;
+  manifest.textures = {PLAYFIELD_TEXTURE};
+  manifest.images = getMinoFiles();
+  manifest.sounds = {MOVE_SOUND, ROTATE_SOUND, LOCK_SOUND};
+  return manifest;
 }
 
-void GameplayScene::Update() {
-  float deltaTime = GetFrameTime();
+// Starts a new game with a random seed
+void GameplayScene::startGame() {
+  startGame((uint64_t)std::random_device{}() << 32 | std::random_device{}());
+}
 
-  // Always update animations
-  playfield->Update();
+// Starts a new game with the given seed, recording it to REPLAYS_DIR
+void GameplayScene::startGame(uint64_t seed) {
+  if (recorder.isRecording()) {
+    recorder.finish(game);
+  }
 
-  // Pause game logic during line clear animations
-  if (playfield->isAnimationRunning()) {
+  game = Game(seed, getLaunchOptions().tickRate);
+  previousTetrimino = game.getCurrentTetrimino();
+  previousPieceCount = game.getPieceCount();
+  refreshView();
+
+  if (!getLaunchOptions().record) {
     return;
   }
 
-  float currentFallSpeed = getFallSpeed();
-  fallTimer += deltaTime;
-
-  // Check if the current tetrimino should fall 1 row down
-  if (fallTimer >= currentFallSpeed && !currentTetrimino->isLocked()) {
-    if (!playfield->isTouchingDown(currentTetrimino)) {
-      currentTetrimino->moveDown();
-      currentTetrimino->resetLockTimer(); // Reset lock timer
-    } else {
-      if (!currentTetrimino->isLocking()) {
-        // Just landed
-        currentTetrimino->resetLockTimer(); // Reset lock timer
-      }
-    }
-    fallTimer = 0.0f; // Reset fall timer
-  }
+  char fileName[64];
+  time_t now = time(nullptr);
+  strftime(fileName, sizeof(fileName), "%Y%m%d-%H%M%S", localtime(&now));
 
-  // Handle lock delay
-  if (playfield->isTouchingDown(currentTetrimino) && !currentTetrimino->isLocked()) {
-    currentTetrimino->addToLockTimer(deltaTime);
+  std::error_code error;
+  std::filesystem::create_directories(REPLAYS_DIR, error);
+  std::string path = std::string(REPLAYS_DIR) + "/" + fileName + ".rkr";
 
-    if (currentTetrimino->getLockTimer() >= LOCK_DELAY) {
-      std::cout << "Locking tetrimino after " << currentTetrimino->getLockTimer() << " seconds."
-                << std::endl;
-      currentTetrimino->lock();
+  if (!recorder.open(path, game, seed)) {
+    std::cerr << "Could not record the game to " << path << std::endl;
+  }
+}
 
-      Sound lockSfx = SoundManager::getInstance().getSound("soundss.wav");
-      PlaySound(lockSfx);
-    }
+void GameplayScene::startBotGame(uint64_t seed, const BotConfig &config) {
+  replayPlayer.reset();
+  bot = std::make_unique<Bot>(config);
+  startGame(seed);
+}
 
-    // Reset lock timer if piece moves away from the bottom
-    // if (!playfield->isTouchingDown(currentTetrimino)) {
-    //   currentTetrimino->resetLockTimer(); // Reset lock timer
-    // }
+void GameplayScene::startReplay(const std::string &path) {
+  if (!replay.open(path)) {
+    std::cerr << "Could not open the replay " << path << ", starting a new game" << std::endl;
+    startGame();
+    return;
   }
 
-  if (currentTetrimino->isLocked() && !playfield->isAnimationRunning()) {
-    playfield->addTetriminoToGrid(currentTetrimino); // Add the tetrimino to the grid
+  replayPlayer = std::make_unique<ReplayPlayer>(replay);
+  replayPlayer->restart(game);
+  refreshView();
+}
 
-    // Check for and clear completed lines
-    // int linesCleared = playfield->clearCompletedLines();
-    std::vector<int> completedRows = playfield->getCompletedRows();
+void GameplayScene::seekReplay(float seconds) {
+  long tick = replayPlayer->getTick() + (long)(seconds * replay.getTickRate());
+  replayPlayer->seek(tick < 0 ? 0 : tick, game);
 
-    if (!completedRows.empty()) {
-      // Start animation instead of immediate clearing
-      playfield->startLineClearAnimation(completedRows);
-      // playfield->executeLineClear();
-      handleLineClears(completedRows.size());
-    }
-  }
+  // Jump straight there, nothing to animate from
+  previousTetrimino = game.getCurrentTetrimino();
+  previousPieceCount = game.getPieceCount();
+  refreshView();
+}
 
-  // Generate a new tetrimino only if the current one is locked and no animation is running
-  if (currentTetrimino->isLocked()) {
-    delete currentTetrimino;                // Clean up the old tetrimino
-    currentTetrimino = generateTetrimino(); // Create a new one
-    return;
-  }
+// Brings what is drawn from textures (the stack, the HUD) up to date with the game. Textures can't
+// be drawn to while a frame is being drawn, so this happens whenever the game changes instead.
+void GameplayScene::refreshView() {
+  playfield.Update(game);
+  scoreLabel.set(game.getScore());
+  levelLabel.set(game.getLevel());
+  linesLabel.set(game.getLinesCleared());
+}
 
-  handleInput(deltaTime);
+// Maps the keyboard to the buttons the game understands (the ones currently held down)
+uint8_t GameplayScene::readInputs() const {
+  uint8_t inputs = 0;
+
+  if (IsKeyDown(KEY_LEFT))
+    inputs |= INPUT_LEFT;
+  if (IsKeyDown(KEY_RIGHT))
+    inputs |= INPUT_RIGHT;
+  if (IsKeyDown(KEY_DOWN))
+    inputs |= INPUT_DOWN;
+  if (IsKeyDown(KEY_UP))
+    inputs |= INPUT_ROTATE;
+  if (IsKeyDown(KEY_SPACE))
+    inputs |= INPUT_HARD_DROP;
+
+  return inputs;
 }
 
-void GameplayScene::handleInput(float deltaTime) {
-  /********************************************
-   * UP KEY HANDLING (ROTATION CLOCKWISE)
-   ********************************************/
-  if (IsKeyPressed(KEY_UP) && !currentTetrimino->isLocked()) {
-    RotateCurrentTetrimino(ROTATE_DIRECTION::RIGHT);
-    currentTetrimino->resetLockTimer(); // Reset lock timer
-    Sound rotateSfx = SoundManager::getInstance().getSound("rotate_new.wav");
-    PlaySound(rotateSfx);
-  }
+void GameplayScene::playSounds(uint32_t events) {
+  const SoundManager &soundManager = SoundManager::getInstance();
 
-  /********************************************
-   * SPACE KEY HANDLING (HARD DROP)
-   ********************************************/
-  if (IsKeyPressed(KEY_SPACE) && !currentTetrimino->isLocked()) {
-    // TODO: this is to be used for points
-    int dropDistance = 0;
+  if (events & EVENT_MOVE) {
+    PlaySound(soundManager.getSound(moveSound));
+  }
 
-    while (!playfield->isTouchingDown(currentTetrimino)) {
-      currentTetrimino->moveDown();
-      dropDistance++;
-    }
+  if (events & EVENT_ROTATE) {
+    PlaySound(soundManager.getSound(rotateSound));
+  }
 
-    currentTetrimino->lock();
+  if (events & EVENT_LOCK) {
+    const Sound &lockSfx = soundManager.getSound(lockSound);
+    SetSoundPitch(lockSfx, 1.0f);
+    PlaySound(lockSfx);
+  }
 
+  if (events & EVENT_HARD_DROP) {
     // TODO: maybe play a different sound for hard drop
-    Sound lockSfx = SoundManager::getInstance().getSound("soundss.wav");
+    const Sound &lockSfx = soundManager.getSound(lockSound);
     SetSoundPitch(lockSfx, 4.1f);
     PlaySound(lockSfx);
   }
 
-  /********************************************
-   * RIGHT KEY HANDLING
-   ********************************************/
-  if (IsKeyDown(KEY_RIGHT) && !currentTetrimino->isLocked()) {
-    if (IsKeyPressed(KEY_RIGHT)) {
-      // First press, move immediately
-      if (!playfield->isTouchingRight(currentTetrimino)) {
-        currentTetrimino->resetLockTimer(); // Reset lock timer
-        currentTetrimino->moveRight();
-        Sound moveSfx = SoundManager::getInstance().getSound("move_new.wav");
-        PlaySound(moveSfx);
-      }
-      rightKeyTimer = KEY_REPEAT_DELAY; // Set initial delay
-    } else {
-      // Key held down - check timer
-      rightKeyTimer -= deltaTime;
-      if (rightKeyTimer <= 0.0f) {
-        if (!playfield->isTouchingRight(currentTetrimino)) {
-          currentTetrimino->resetLockTimer(); // Reset lock timer
-          currentTetrimino->moveRight();
-          Sound moveSfx = SoundManager::getInstance().getSound("move_new.wav");
-          PlaySound(moveSfx);
-        }
-        rightKeyTimer = KEY_REPEAT_RATE; // Set repeat rate
-      }
-    }
-  } else {
-    rightKeyTimer = 0.0f; // Reset timer when key released
+  if (events & EVENT_LEVEL_UP) {
+    std::cout << "Level up! New level: " << game.getLevel() << std::endl;
   }
+}
 
-  /********************************************
-   * LEFT KEY HANDLING
-   ********************************************/
-  if (IsKeyDown(KEY_LEFT) && !currentTetrimino->isLocked()) {
-    if (IsKeyPressed(KEY_LEFT)) {
-      // First press, move immediately
-      if (!playfield->isTouchingLeft(currentTetrimino)) {
-        currentTetrimino->resetLockTimer(); // Reset lock timer
-        currentTetrimino->moveLeft();
-      }
-      leftKeyTimer = KEY_REPEAT_DELAY; // Set initial delay
-    } else {
-      // Key held down - check timer
-      leftKeyTimer -= deltaTime;
-      if (leftKeyTimer <= 0.0f) {
-        if (!playfield->isTouchingLeft(currentTetrimino)) {
-          currentTetrimino->resetLockTimer(); // Reset lock timer
-          currentTetrimino->moveLeft();
-        }
-        leftKeyTimer = KEY_REPEAT_RATE; // Set repeat rate
-      }
+void GameplayScene::PollInput() {
+  long allocations = getAllocationCount();
+  lastFrameAllocations = allocations - frameStartAllocations;
+  frameStartAllocations = allocations;
+
+  if (replayPlayer) {
+    if (IsKeyPressed(KEY_LEFT))
+      seekReplay(-REPLAY_SEEK_SECONDS);
+    if (IsKeyPressed(KEY_RIGHT))
+      seekReplay(REPLAY_SEEK_SECONDS);
+    if (IsKeyPressed(KEY_ENTER)) {
+      replayPlayer->restart(game);
+      refreshView();
     }
-  } else {
-    leftKeyTimer = 0.0f; // Reset timer when key released
+    return;
   }
 
-  /********************************************
-   * DOWN KEY HANDLING
-   ********************************************/
-  if (IsKeyDown(KEY_DOWN) && !currentTetrimino->isLocked()) {
-    if (IsKeyPressed(KEY_DOWN)) {
-      if (!playfield->isTouchingDown(currentTetrimino)) {
-        currentTetrimino->moveDown(true);
-      }
-      downKeyTimer = KEY_REPEAT_DELAY; // Set initial delay
-    } else {
-      // Key held down - check timer
-      downKeyTimer -= deltaTime;
-      if (downKeyTimer <= 0.0f) {
-        if (!playfield->isTouchingDown(currentTetrimino)) {
-          currentTetrimino->moveDown(false);
-        }
-        downKeyTimer = KEY_REPEAT_RATE; // Set repeat rate
-      }
-    }
-  } else {
-    downKeyTimer = 0.0f; // Reset timer when key released
+  // Start over once the stack reached the top
+  if (game.isToppedOut() && IsKeyPressed(KEY_ENTER)) {
+    startGame();
   }
+
+  // Keys can be pressed and released before the next tick, so we keep them until it happens
+  pendingInputs |= readInputs();
+  if (IsKeyPressed(KEY_LEFT))
+    pendingInputs |= INPUT_LEFT;
+  if (IsKeyPressed(KEY_RIGHT))
+    pendingInputs |= INPUT_RIGHT;
+  if (IsKeyPressed(KEY_DOWN))
+    pendingInputs |= INPUT_DOWN;
+  if (IsKeyPressed(KEY_UP))
+    pendingInputs |= INPUT_ROTATE;
+  if (IsKeyPressed(KEY_SPACE))
+    pendingInputs |= INPUT_HARD_DROP;
 }
 
-void GameplayScene::handleLineClears(int linesCleared) {
-  if (linesCleared <= 0)
+void GameplayScene::Update() {
+  if (game.isToppedOut()) {
     return;
+  }
 
-  // Update total lines cleared
-  totalLinesCleared += linesCleared;
+  uint8_t inputs;
 
-  // Update score based on the number of lines cleared
-  updateScore(linesCleared);
+  if (replayPlayer) {
+    if (replayPlayer->isFinished()) {
+      return;
+    }
+    inputs = replayPlayer->nextInputs(game);
+  } else {
+    inputs = bot ? bot->nextInputs(game) : pendingInputs | readInputs();
+    pendingInputs = 0;
+    recorder.record(game, inputs);
+  }
 
-  // Check if we need to increase the level (typically every 10 lines)
-  updateLevel();
+  previousTetrimino = game.getCurrentTetrimino();
+  previousPieceCount = game.getPieceCount();
 
-  // Play sound effect based on the number of lines cleared
-  // SoundManager::getInstance().playLineClearSound(linesCleared);
-}
+  uint32_t events = game.step(inputs);
+  playSounds(events);
 
-void GameplayScene::updateScore(int linesCleared) {
-  int basePoints = 0;
-
-  switch (linesCleared) {
-  case 1:
-    basePoints = SINGLE_LINE_SCORE; // 40 points for a single line clear
-    break;
-  case 2:
-    basePoints = DOUBLE_LINE_SCORE; // 100 points for a double line clear
-    break;
-  case 3:
-    basePoints = TRIPLE_LINE_SCORE; // 300 points for a triple line clear
-    break;
-  case 4:
-    basePoints = TETRIS_LINE_SCORE; // 1200 points for a Tetris (four lines clear)
-    break;
-  default:
-    return; // No points for invalid line clears
+  if (game.isToppedOut() && recorder.isRecording()) {
+    recorder.finish(game);
   }
 
-  // Score is multiplied by the current level (official Tetris scoring)
-  currentScore += basePoints * currentLevel;
+  refreshView();
 }
 
-void GameplayScene::updateLevel() {
-  // Standard rule: level increases every 10 lines cleared
-  int newLevel = (totalLinesCleared / 10) + 1;
-
-  if (newLevel > currentLevel) {
-    currentLevel = newLevel;
-    // Optionally, you can play a sound effect or display a message when the level increases
-    std::cout << "Level up! New level: " << currentLevel << std::endl;
-    // SoundManager::getInstance().playLevelUpSound();
+// How far (in squares) the current tetrimino has to be drawn from its position in the grid, to be
+// in between where it was before the last tick and where it is now. Moving one square at a time
+// looks smooth, anything else (a new tetrimino, a rotation, a hard drop) just jumps there.
+Vector2 GameplayScene::getInterpolationOffset(float interpolation) const {
+  const Tetrimino &current = game.getCurrentTetrimino();
+  int deltaCol = current.getCol() - previousTetrimino.getCol();
+  int deltaRow = current.getRow() - previousTetrimino.getRow();
+
+  if (game.getPieceCount() != previousPieceCount ||
+      current.getRotationIndex() != previousTetrimino.getRotationIndex() || abs(deltaCol) > 1 ||
+      abs(deltaRow) > 1) {
+    return {0, 0};
   }
+
+  return {-deltaCol * (1.0f - interpolation), -deltaRow * (1.0f - interpolation)};
 }
 
-void GameplayScene::Draw() {
+void GameplayScene::Draw(float interpolation) {
   ClearBackground(BLACK);
 
-  playfield->Draw();
+  float lockTimer = game.ticksToSeconds(game.getCurrentTetrimino().getLockTimer());
+
+  // The minos all come from the same atlas, drawn one after the other they make a single batch.
+  // Text uses the font texture, so it goes after them.
+  playfield.Draw(game.getGrid());
+
+  if (!playfield.isAnimationRunning()) {
+    playfield.drawTetrimino(game.getCurrentTetrimino(), MINO_BLOCK,
+                            getInterpolationOffset(interpolation),
+                            lockTimer > 0 ? 0.7f - lockTimer : 1);
+    playfield.drawTetrimino(game.getGhostPiece(), MINO_GHOST);
+  }
+
+  scoreLabel.Draw(10, 20);
+  levelLabel.Draw(10, 40);
+  linesLabel.Draw(10, 60);
 
-  DrawText(TextFormat("Score: %ld", currentScore), 10, 20, 15, WHITE);
-  DrawText(TextFormat("Level: %d", currentLevel), 10, 40, 15, WHITE);
-  DrawText(TextFormat("Lines: %d", totalLinesCleared), 10, 60, 15, WHITE);
-  DrawText(TextFormat("lockTimer: %02.02f", currentTetrimino->getLockTimer()), 10, 110, 15, GREEN);
-  DrawText(TextFormat("fallSpeed: %02.02f", getFallSpeed()), 10, 130, 15, YELLOW);
-  DrawText(TextFormat("fallTimer: %02.02f", fallTimer), 10, 150, 15, YELLOW);
+#ifdef RIKTRIS_DIAGNOSTICS
+  DrawText(TextFormat("lockTimer: %02.02f", lockTimer), 10, 110, 15, GREEN);
+  DrawText(TextFormat("fallSpeed: %02.02f", game.ticksToSeconds(game.getFallSpeed())), 10, 130, 15,
+           YELLOW);
+  DrawText(TextFormat("fallTimer: %02.02f", game.ticksToSeconds(game.getFallTimer())), 10, 150, 15,
+           YELLOW);
   DrawText(TextFormat("deltaTime: %02.02f", GetFrameTime()), 10, 170, 15, YELLOW);
-  DrawText(TextFormat("animating: %s", playfield->isAnimationRunning() ? "TRUE" : "FALSE"), 10, 200,
+  DrawText(TextFormat("animating: %s", playfield.isAnimationRunning() ? "TRUE" : "FALSE"), 10, 200,
            15, BLUE);
 
-  Tetrimino *ghostTetrimino = getGhostPiece().release();
+  if (getAllocationCount() >= 0) {
+    DrawText(TextFormat("allocs/frame: %ld", lastFrameAllocations), 10, 220, 15, BLUE);
+  }
+#endif
 
-  int startX = playfield->getDrawStart().x;
-  int startY = playfield->getDrawStart().y;
+  if (bot) {
+    DrawText(TextFormat("BOT (search: %ldus)", bot->getSearchMicros()), 10, 320, 15, ORANGE);
+  }
 
-  if (!playfield->isAnimationRunning()) {
-    currentTetrimino->Draw(startX, startY, MINO_BLOCK);
-    ghostTetrimino->Draw(startX, startY, MINO_GHOST);
+  if (replayPlayer) {
+    DrawText(TextFormat("REPLAY %.0fs / %.0fs", game.ticksToSeconds(replayPlayer->getTick()),
+                        game.ticksToSeconds(replay.getSummary().ticks)),
+             10, 320, 15, ORANGE);
+    DrawText("LEFT / RIGHT to seek, ENTER to restart", 10, 340, 15, ORANGE);
+  }
+
+  if (game.isToppedOut()) {
+    DrawText("GAME OVER", 10, 250, 20, RED);
+    if (!replayPlayer) {
+      DrawText("Press ENTER to play again", 10, 275, 15, WHITE);
+    }
   }
 
   DrawFPS(WINDOW_W - 30, 0);
@@ -1,51 +1,71 @@
 #pragma once
 
+#include "../core/bot.h"
+#include "../core/game.h"
+#include "../core/replay.h"
+#include "../hud_label.h"
 #include "../playfield.h"
-#include "../tetrimino_bag.h"
+#include "../asset_queue.h"
+#include "../sound_manager.h"
 #include "game_scene.h"
+#include <cstdint>
+#include <memory>
 #include <string>
 
 class GameplayScene : public GameScene {
 private:
-  Playfield *playfield;
-  Tetrimino *currentTetrimino;
-  TetriminoBag *tetriminoBag;
-
-  int currentLevel = 1;      // Current level
-  long currentScore = 0;     // Current score
-  int totalLinesCleared = 0; // Total lines cleared
-
-  // Line clear scoring (official Tetris scoring)
-  static const int SINGLE_LINE_SCORE = 40;
-  static const int DOUBLE_LINE_SCORE = 100;
-  static const int TRIPLE_LINE_SCORE = 300;
-  static const int TETRIS_LINE_SCORE = 1200;
-
-  void RotateCurrentTetrimino(ROTATE_DIRECTION direction);
-  bool WallKick(int fromIndex, int toIndex) const;
-  float getFallSpeed();
-  void handleInput(float deltaTime);
-  void handleLineClears(int linesCleared);
-  void updateScore(int linesCleared);
-  void updateLevel();
-  Tetrimino *generateTetrimino() {
-    TETRIMINO_SHAPE nextShape = tetriminoBag->getNextShape();
-    return new Tetrimino(nextShape, getFallSpeed());
-  }
-  std::unique_ptr<Tetrimino> getGhostPiece() {
-    auto ghost = std::make_unique<Tetrimino>(*currentTetrimino);
-
-    while (!playfield->isTouchingDown(ghost.get())) {
-      ghost->moveDown();
-    }
-    return ghost;
-  }
-
-  // Don't spawn a new tetrimino during animation
-  bool canGenerateNewTetrimino() const;
+  Playfield playfield;
+  Game game;
+
+  uint8_t pendingInputs = 0; // Buttons pressed since the last tick
+
+  // Every game played is recorded to REPLAYS_DIR. When watching a replay, the player gives the
+  // inputs to the game instead of the keyboard.
+  ReplayRecorder recorder;
+  Replay replay;
+  std::unique_ptr<ReplayPlayer> replayPlayer;
+
+  std::unique_ptr<Bot> bot; // Plays instead of the keyboard when started with --bot
+
+  // Where the current tetrimino was before the last tick, to draw it moving smoothly
+  Tetrimino previousTetrimino;
+  long previousPieceCount = 0;
+
+  // Looked up once when the scene is created, played by handle
+  SoundHandle moveSound;
+  SoundHandle rotateSound;
+  SoundHandle lockSound;
+
+  // The HUD rows that come from the game, redrawn only when their value changes
+  HudLabel scoreLabel;
+  HudLabel levelLabel;
+  HudLabel linesLabel;
+
+  // Heap allocations at the start of this frame and during the last one (see allocation_counter.h)
+  long frameStartAllocations = 0;
+  long lastFrameAllocations = 0;
+
+  void startGame();
+  void startGame(uint64_t seed);
+  void startReplay(const std::string &path);
+  void seekReplay(float seconds);
+  uint8_t readInputs() const;
+  Vector2 getInterpolationOffset(float interpolation) const;
+  void playSounds(uint32_t events);
+  void refreshView();
 
 public:
   explicit GameplayScene(const std::string &name);
+  ~GameplayScene();
+
+  static AssetManifest getManifest();
+
+  // Starts a game with the given seed, played by the bot with the given settings. The same seed and
+  // settings always give the same game, which is what the frame budget harness relies on.
+  void startBotGame(uint64_t seed, const BotConfig &config);
+  const Game &getGame() const { return game; }
+
+  void PollInput() override;
   void Update() override;
-  void Draw() override;
+  void Draw(float interpolation) override;
 };
@@ -1,5 +1,7 @@
 
 #include "sound_manager.h"
+#include "asset_loader.h"
+#include "startup_trace.h"
 #include <iostream>
 
 SoundManager &SoundManager::getInstance() {
@@ -7,41 +9,69 @@ SoundManager &SoundManager::getInstance() {
   return instance;
 }
 
-const Sound &SoundManager::getSound(const std::string &filename) {
-  auto it = sounds.find(filename);
+// The handle of the file, given a slot the first time it's seen
+SoundHandle SoundManager::getHandle(const std::string &filename) {
+  auto it = handles.find(filename);
+
+  if (it != handles.end()) {
+    return it->second;
+  }
+
+  SoundHandle handle = (SoundHandle)sounds.size();
+  sounds.push_back({{}, false});
+  handles[filename] = handle;
+  return handle;
+}
+
+SoundHandle SoundManager::loadSound(const std::string &filename) {
+  SoundHandle handle = getHandle(filename);
+  Entry &entry = sounds[handle];
+
+  if (!entry.loaded) {
+    StartupSpan span("load sound " + filename, "sound");
 
-  if (it == sounds.end()) {
     // Load sound if not found
     std::cout << "Loading sound: " << SOUND_DIR << filename << std::endl;
 
     std::string fullPath = SOUND_DIR + filename;
 
-    Sound sound = LoadSound(fullPath.c_str());
-    sounds[filename] = sound;
-    return sounds[filename];
+    entry.sound = loadSoundAsset(fullPath);
+    entry.loaded = true;
+  }
+  return handle;
+}
+
+void SoundManager::addSound(const std::string &filename, const Wave &wave) {
+  Entry &entry = sounds[getHandle(filename)];
+
+  if (!entry.loaded) {
+    StartupSpan span("upload sound " + filename, "sound");
+    entry.sound = LoadSoundFromWave(wave);
+    entry.loaded = true;
   }
-  return it->second;
 }
 
 void SoundManager::preloadSound(const std::string &filename) {
-  getSound(filename); // This will load it if not already loaded
+  loadSound(filename); // This will load it if not already loaded
 }
 
 void SoundManager::unloadSound(const std::string &filename) {
-  auto it = sounds.find(filename);
+  auto it = handles.find(filename);
 
-  if (it != sounds.end()) {
-    UnloadSound(it->second);
-    sounds.erase(it);
+  if (it != handles.end() && sounds[it->second].loaded) {
+    UnloadSound(sounds[it->second].sound);
+    sounds[it->second].loaded = false;
     std::cout << "Unloaded sound: " << filename << std::endl;
   }
 }
 
 void SoundManager::unloadAll() {
-  for (auto &pair : sounds) {
-    UnloadSound(pair.second);
+  for (Entry &entry : sounds) {
+    if (entry.loaded) {
+      UnloadSound(entry.sound);
+      entry.loaded = false;
+    }
   }
-  sounds.clear();
   std::cout << "Unloaded all sounds" << std::endl;
 }
 
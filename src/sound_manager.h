@@ -3,28 +3,47 @@
 #include <raylib.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 const std::string SOUND_DIR = "data/sfx/";
 
+// Index of a loaded sound, stable for as long as the program runs (see TextureHandle)
+typedef int SoundHandle;
+
 class SoundManager {
 private:
-  std::unordered_map<std::string, Sound> sounds;
+  struct Entry {
+    Sound sound;
+    bool loaded;
+  };
+
+  std::vector<Entry> sounds; // Indexed by handle
+  std::unordered_map<std::string, SoundHandle> handles;
 
   SoundManager() = default;
 
+  SoundHandle getHandle(const std::string &filename);
+
 public:
   static SoundManager &getInstance();
 
-  // Load sound if not already loaded, return reference to cached sound
-  const Sound &getSound(const std::string &filename);
+  // Load sound if not already loaded, return the handle to play it with. This is the only lookup by
+  // name, do it once when loading and keep the handle.
+  SoundHandle loadSound(const std::string &filename);
+
+  // Uploads a wave decoded on another thread (see AssetQueue), unless it's loaded already. The
+  // wave still belongs to the caller.
+  void addSound(const std::string &filename, const Wave &wave);
+
+  const Sound &getSound(SoundHandle handle) const { return sounds[handle].sound; }
 
   // Preload sound
   void preloadSound(const std::string &filename);
 
-  // Unload specific sound
+  // Unload specific sound. Its handle can still be loaded again.
   void unloadSound(const std::string &filename);
 
-  // Unload all sounds
+  // Unload all sounds (the handles stay valid)
   void unloadAll();
 
   ~SoundManager();
@@ -0,0 +1,129 @@
+#include "startup_trace.h"
+#include <algorithm>
+#include <cstdio>
+
+// How many of the longest main thread spans the summary names
+#define SUMMARY_SPANS 3
+
+StartupTrace &StartupTrace::getInstance() {
+  static StartupTrace instance;
+  return instance;
+}
+
+int StartupTrace::getThreadNumber(std::thread::id id) {
+  auto it = std::find(threads.begin(), threads.end(), id);
+
+  if (it != threads.end()) {
+    return it - threads.begin();
+  }
+
+  threads.push_back(id);
+  return threads.size() - 1;
+}
+
+void StartupTrace::add(const std::string &name, const char *category,
+                       std::chrono::steady_clock::time_point spanStart,
+                       std::chrono::steady_clock::time_point spanEnd) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (finished) {
+    return;
+  }
+
+  spans.push_back({name, category, getThreadNumber(std::this_thread::get_id()),
+                   (long)duration_cast<microseconds>(spanStart - start).count(),
+                   (long)duration_cast<microseconds>(spanEnd - spanStart).count()});
+}
+
+// Names are file names and the like, only quotes and backslashes need escaping
+static std::string escapeJson(const std::string &text) {
+  std::string escaped;
+
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+bool StartupTrace::writeChromeTrace(const std::string &path, long firstFrameMicros) {
+  FILE *file = fopen(path.c_str(), "w");
+  if (!file) {
+    return false;
+  }
+
+  fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+
+  for (size_t thread = 0; thread < threads.size(); thread++) {
+    fprintf(file,
+            "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %zu, "
+            "\"args\": {\"name\": \"%s\"}},\n",
+            thread, thread == 0 ? "main" : "asset loader");
+  }
+
+  for (const Span &span : spans) {
+    fprintf(file,
+            "  {\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, "
+            "\"ts\": %ld, \"dur\": %ld},\n",
+            escapeJson(span.name).c_str(), span.category, span.thread, span.startMicros,
+            span.durationMicros);
+  }
+
+  fprintf(file,
+          "  {\"name\": \"first frame presented\", \"ph\": \"i\", \"s\": \"g\", \"pid\": 1, "
+          "\"tid\": 0, \"ts\": %ld}\n]}\n",
+          firstFrameMicros);
+
+  return fclose(file) == 0;
+}
+
+void StartupTrace::finish(const std::string &path) {
+  long firstFrameMicros = std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (finished) {
+    return;
+  }
+  finished = true;
+
+  // The longest spans of the main thread, that everything else waited for
+  std::vector<const Span *> longest;
+  for (const Span &span : spans) {
+    if (span.thread == 0) {
+      longest.push_back(&span);
+    }
+  }
+
+  size_t count = std::min(longest.size(), (size_t)SUMMARY_SPANS);
+  std::partial_sort(longest.begin(), longest.begin() + count, longest.end(),
+                    [](const Span *a, const Span *b) {
+                      return a->durationMicros > b->durationMicros;
+                    });
+
+  printf("Startup: first frame after %.1f ms, %zu spans", firstFrameMicros / 1000.0, spans.size());
+  for (size_t i = 0; i < count; i++) {
+    printf("%s %s %.1f ms", i == 0 ? ", longest:" : ",", longest[i]->name.c_str(),
+           longest[i]->durationMicros / 1000.0);
+  }
+  printf("\n");
+
+  if (!path.empty()) {
+    if (writeChromeTrace(path, firstFrameMicros)) {
+      printf("Startup trace written to %s\n", path.c_str());
+    } else {
+      fprintf(stderr, "Could not write the startup trace to %s\n", path.c_str());
+    }
+  }
+
+  // Nothing is recorded from now on
+  spans.clear();
+  spans.shrink_to_fit();
+}
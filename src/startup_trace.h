@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Times what happens between launching the game and its first frame on screen: the window and
+// audio device, mounting the assets, creating the first scene, every texture and sound loaded (and
+// decoded, on the background threads). When the first frame is presented it prints a one-line
+// summary and, with --startup-trace, writes everything as a Chrome trace (chrome://tracing or
+// https://ui.perfetto.dev) where the main thread is the critical path.
+//
+// Spans can be recorded from any thread. After the first frame nothing more is recorded.
+class StartupTrace {
+private:
+  struct Span {
+    std::string name;
+    const char *category;
+    int thread; // 0 is the main thread
+    long startMicros;
+    long durationMicros;
+  };
+
+  std::chrono::steady_clock::time_point start;
+  std::mutex mutex;
+  std::vector<Span> spans;
+  std::vector<std::thread::id> threads; // Index is the thread number in the trace
+  bool finished = false;
+
+  // The main thread creates the trace, first thing in main
+  StartupTrace() : start(std::chrono::steady_clock::now()), threads{std::this_thread::get_id()} {}
+
+  int getThreadNumber(std::thread::id id);
+  bool writeChromeTrace(const std::string &path, long firstFrameMicros);
+
+public:
+  static StartupTrace &getInstance();
+
+  StartupTrace(const StartupTrace &) = delete;
+  StartupTrace &operator=(const StartupTrace &) = delete;
+
+  void add(const std::string &name, const char *category,
+           std::chrono::steady_clock::time_point spanStart,
+           std::chrono::steady_clock::time_point spanEnd);
+
+  // The first frame is on screen: prints the summary and writes the trace to path (if not empty)
+  void finish(const std::string &path);
+};
+
+// Records the time from its construction to the end of the scope
+class StartupSpan {
+private:
+  std::string name;
+  const char *category;
+  std::chrono::steady_clock::time_point start;
+
+public:
+  StartupSpan(const std::string &name, const char *category = "startup")
+      : name(name), category(category), start(std::chrono::steady_clock::now()) {}
+  ~StartupSpan() {
+    StartupTrace::getInstance().add(name, category, start, std::chrono::steady_clock::now());
+  }
+
+  StartupSpan(const StartupSpan &) = delete;
+  StartupSpan &operator=(const StartupSpan &) = delete;
+};
@@ -1,4 +1,7 @@
 #include "texture_manager.h"
+#include "asset_loader.h"
+#include "startup_trace.h"
+#include <algorithm>
 #include <iostream>
 
 TextureManager &TextureManager::getInstance() {
@@ -6,41 +9,137 @@ TextureManager &TextureManager::getInstance() {
   return instance;
 }
 
-const Texture2D &TextureManager::getTexture(const std::string &filename) {
-  auto it = textures.find(filename);
+// The handle of the file, given a slot the first time it's seen
+TextureHandle TextureManager::getHandle(const std::string &filename) {
+  auto it = handles.find(filename);
+
+  if (it != handles.end()) {
+    return it->second;
+  }
+
+  TextureHandle handle = (TextureHandle)textures.size();
+  textures.push_back({{}, false});
+  handles[filename] = handle;
+  return handle;
+}
+
+TextureHandle TextureManager::loadTexture(const std::string &filename) {
+  TextureHandle handle = getHandle(filename);
+  Entry &entry = textures[handle];
+
+  if (!entry.loaded) {
+    StartupSpan span("load texture " + filename, "texture");
 
-  if (it == textures.end()) {
     // Load texture if not found
     std::cout << "Loading texture: " << TEXTURES_DIR << filename << std::endl;
 
     std::string fullPath = TEXTURES_DIR + filename;
 
-    Texture2D texture = LoadTexture(fullPath.c_str());
-    textures[filename] = texture;
-    return textures[filename];
+    entry.texture = loadTextureAsset(fullPath);
+    entry.loaded = true;
+  }
+  return handle;
+}
+
+const TextureAtlas &TextureManager::getAtlas(const std::string &name,
+                                             const std::vector<std::string> &filenames) {
+  auto it = atlases.find(name);
+
+  if (it != atlases.end()) {
+    return it->second;
+  }
+
+  StartupSpan span("build atlas " + name, "texture");
+  std::cout << "Building atlas: " << name << " (" << filenames.size() << " images)" << std::endl;
+
+  std::vector<Image> atlasImages;
+  int width = 0;
+  int height = 0;
+
+  for (const std::string &filename : filenames) {
+    auto decoded = images.find(filename);
+
+    if (decoded != images.end()) {
+      atlasImages.push_back(decoded->second);
+      images.erase(decoded);
+    } else {
+      atlasImages.push_back(loadImageAsset(TEXTURES_DIR + filename));
+    }
+    width += atlasImages.back().width + ATLAS_PADDING;
+    height = std::max(height, atlasImages.back().height);
+  }
+
+  // The images go in a single row, left to right
+  TextureAtlas atlas;
+  Image canvas = GenImageColor(std::max(width, 1), std::max(height, 1), BLANK);
+  float x = 0;
+
+  for (const Image &image : atlasImages) {
+    Rectangle frame = {x, 0, (float)image.width, (float)image.height};
+
+    ImageDraw(&canvas, image, {0, 0, frame.width, frame.height}, frame, WHITE);
+    atlas.frames.push_back(frame);
+    x += image.width + ATLAS_PADDING;
+
+    UnloadImage(image);
+  }
+
+  atlas.texture = LoadTextureFromImage(canvas);
+  UnloadImage(canvas);
+
+  return atlases[name] = atlas;
+}
+
+void TextureManager::addTexture(const std::string &filename, const Image &image) {
+  Entry &entry = textures[getHandle(filename)];
+
+  if (!entry.loaded) {
+    StartupSpan span("upload texture " + filename, "texture");
+    entry.texture = LoadTextureFromImage(image);
+    entry.loaded = true;
   }
-  return it->second;
+}
+
+void TextureManager::addImage(const std::string &filename, const Image &image) {
+  auto it = images.find(filename);
+
+  if (it != images.end()) {
+    UnloadImage(it->second);
+  }
+  images[filename] = image;
 }
 
 void TextureManager::preloadTexture(const std::string &filename) {
-  getTexture(filename); // This will load it if not already loaded
+  loadTexture(filename); // This will load it if not already loaded
 }
 
 void TextureManager::unloadTexture(const std::string &filename) {
-  auto it = textures.find(filename);
+  auto it = handles.find(filename);
 
-  if (it != textures.end()) {
-    UnloadTexture(it->second);
-    textures.erase(it);
+  if (it != handles.end() && textures[it->second].loaded) {
+    UnloadTexture(textures[it->second].texture);
+    textures[it->second].loaded = false;
     std::cout << "Unloaded texture: " << filename << std::endl;
   }
 }
 
 void TextureManager::unloadAll() {
-  for (auto &pair : textures) {
-    UnloadTexture(pair.second);
+  for (Entry &entry : textures) {
+    if (entry.loaded) {
+      UnloadTexture(entry.texture);
+      entry.loaded = false;
+    }
+  }
+
+  for (auto &pair : atlases) {
+    UnloadTexture(pair.second.texture);
+  }
+  atlases.clear();
+
+  for (auto &pair : images) {
+    UnloadImage(pair.second);
   }
-  textures.clear();
+  images.clear();
   std::cout << "Unloaded all textures" << std::endl;
 }
 
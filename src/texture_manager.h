@@ -3,28 +3,69 @@
 #include <raylib.h>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 const std::string TEXTURES_DIR = "data/gfx/";
 
+// Index of a loaded texture. It stays the same for as long as the program runs, even if the texture
+// is unloaded and loaded again, so it can be kept instead of the file name.
+typedef int TextureHandle;
+
+// Transparent pixels between the images of an atlas, so a frame never picks up its neighbour
+#define ATLAS_PADDING 1
+
+// Several images packed side by side into one texture. Everything drawn from the same texture goes
+// to the GPU in a single batch, while switching textures flushes the batch every time.
+struct TextureAtlas {
+  Texture2D texture;
+  std::vector<Rectangle> frames; // Where each image is in the texture, in the order they were given
+};
+
 class TextureManager {
 private:
-  std::unordered_map<std::string, Texture2D> textures;
+  struct Entry {
+    Texture2D texture;
+    bool loaded;
+  };
+
+  std::vector<Entry> textures; // Indexed by handle
+  std::unordered_map<std::string, TextureHandle> handles;
+  std::unordered_map<std::string, TextureAtlas> atlases;
+  std::unordered_map<std::string, Image> images; // Decoded ahead of time for an atlas
 
   TextureManager() = default;
 
+  TextureHandle getHandle(const std::string &filename);
+
 public:
   static TextureManager &getInstance();
 
-  // Load texture if not already loaded, return reference to cached texture
-  const Texture2D &getTexture(const std::string &filename);
+  // Load texture if not already loaded, return the handle to get it with. This is the only lookup
+  // by name, do it once when loading and keep the handle.
+  TextureHandle loadTexture(const std::string &filename);
+
+  // Uploads a image decoded on another thread (see AssetQueue), unless it's loaded already. The
+  // image still belongs to the caller.
+  void addTexture(const std::string &filename, const Image &image);
+
+  // Keeps a image decoded on another thread until an atlas is built with it. The image now belongs
+  // to TextureManager.
+  void addImage(const std::string &filename, const Image &image);
+
+  const Texture2D &getTexture(TextureHandle handle) const { return textures[handle].texture; }
+
+  // Build the atlas of the given images the first time it's asked for, return the cached one after
+  // that. The name only identifies the atlas, the images are files in TEXTURES_DIR. Images given to
+  // addImage are used as they are, the rest are read and decoded here.
+  const TextureAtlas &getAtlas(const std::string &name, const std::vector<std::string> &filenames);
 
   // Preload texture
   void preloadTexture(const std::string &filename);
 
-  // Unload specific texture
+  // Unload specific texture. Its handle can still be loaded again.
   void unloadTexture(const std::string &filename);
 
-  // Unload all textures
+  // Unload all textures (the handles stay valid)
   void unloadAll();
 
   ~TextureManager();
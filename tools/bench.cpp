@@ -0,0 +1,305 @@
+// Microbenchmarks of the game rules: the grid operations run on every tick, the collision checks
+// and the bag. Each one runs on a few generated boards, from empty to completely full.
+//
+//   riktris_bench [--filter <text>] [--min-time <seconds>] [--json]
+//
+// Prints the time and heap allocations per call of each benchmark, or with --json a JSON array
+// that can be saved and compared between commits. Benchmarks that change the grid work on a copy
+// of it every call, "MinoGrid copy" is how much of their time that copy takes.
+
+#include "allocation_counter.h"
+#include "core/mino_grid.h"
+#include "core/tetrimino_bag.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// Keeps the compiler from optimizing away a result that is never used
+template <typename T> static void keep(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  static volatile const void *sink;
+  sink = &value;
+#endif
+}
+
+struct Fixture {
+  const char *name;
+  MinoGrid grid;
+  std::vector<Tetrimino> pieces; // Positions to test the collision checks with
+};
+
+struct BenchResult {
+  std::string name;
+  long iterations;
+  double nanosPerOp;
+  double allocationsPerOp;
+};
+
+// Columns of random heights, with a hole here and there
+static MinoGrid makeJagged(std::mt19937 &random) {
+  MinoGrid grid;
+  grid.clear();
+
+  for (int col = 0; col < (int)GRID_WIDTH; col++) {
+    int height = random() % 12;
+
+    for (int row = GRID_HEIGHT - height; row < (int)GRID_HEIGHT; row++) {
+      if (random() % 8 != 0) {
+        grid.setCell(col, row, 1 + random() % NUMBER_OF_SHAPES);
+      }
+    }
+  }
+  return grid;
+}
+
+// Every row but the top 4 full except for one square
+static MinoGrid makeNearFull() {
+  MinoGrid grid;
+  grid.clear();
+
+  for (int row = 4; row < (int)GRID_HEIGHT; row++) {
+    for (int col = 0; col < (int)GRID_WIDTH; col++) {
+      if (col != row * 7 % GRID_WIDTH) {
+        grid.setCell(col, row, 1 + (row + col) % NUMBER_OF_SHAPES);
+      }
+    }
+  }
+  return grid;
+}
+
+// Every row is full, all of them get cleared
+static MinoGrid makeComplete() {
+  MinoGrid grid;
+  grid.clear();
+
+  for (int row = 0; row < (int)GRID_HEIGHT; row++) {
+    for (int col = 0; col < (int)GRID_WIDTH; col++) {
+      grid.setCell(col, row, 1 + (row + col) % NUMBER_OF_SHAPES);
+    }
+  }
+  return grid;
+}
+
+// Every shape in every rotation, at random places around the playfield. Some fit and some don't,
+// so the branches of the checks can't all be predicted.
+static std::vector<Tetrimino> makePieces(std::mt19937 &random) {
+  std::vector<Tetrimino> pieces;
+
+  for (int i = 0; i < 256; i++) {
+    Tetrimino piece((TETRIMINO_SHAPE)(i % NUMBER_OF_SHAPES));
+    piece.setRotation(i / NUMBER_OF_SHAPES % NUMBER_OF_ROTATIONS);
+    piece.setCol((int)(random() % (GRID_WIDTH + 2)) - 2);
+    piece.setRow(random() % (GRID_HEIGHT - 2));
+    pieces.push_back(piece);
+  }
+  return pieces;
+}
+
+class BenchRunner {
+private:
+  std::string filter;
+  double minSeconds;
+  std::vector<BenchResult> results;
+
+public:
+  BenchRunner(const std::string &filter, double minSeconds)
+      : filter(filter), minSeconds(minSeconds) {}
+
+  const std::vector<BenchResult> &getResults() const { return results; }
+
+  // Calls op(i) with i counting up from 0, doubling the number of calls until they take at least
+  // minSeconds. The last round is the one reported.
+  template <typename Op> void run(const std::string &name, Op op) {
+    if (name.find(filter) == std::string::npos) {
+      return;
+    }
+
+    for (long iterations = 1;; iterations *= 2) {
+      long allocationsBefore = getAllocationCount();
+      auto start = std::chrono::steady_clock::now();
+
+      for (long i = 0; i < iterations; i++) {
+        op(i);
+      }
+
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      long allocations = getAllocationCount() - allocationsBefore;
+
+      if (elapsed.count() >= minSeconds || iterations >= (1L << 40)) {
+        results.push_back({name, iterations, elapsed.count() * 1e9 / iterations,
+                           (double)allocations / iterations});
+        return;
+      }
+    }
+  }
+};
+
+static void benchFixture(BenchRunner &runner, const Fixture &fixture) {
+  const MinoGrid &grid = fixture.grid;
+  const std::vector<Tetrimino> &pieces = fixture.pieces;
+  size_t mask = pieces.size() - 1;
+  std::string suffix = std::string("/") + fixture.name;
+
+  runner.run("MinoGrid copy" + suffix, [&](long) {
+    MinoGrid copy = grid;
+    keep(copy);
+  });
+
+  runner.run("MinoGrid::getCompletedRows" + suffix, [&](long) {
+    RowList rows = grid.getCompletedRows();
+    keep(rows);
+  });
+
+  // What the game does after every lock
+  runner.run("MinoGrid::getCompletedRows(tetrimino)" + suffix, [&](long i) {
+    RowList rows = grid.getCompletedRows(pieces[i & mask]);
+    keep(rows);
+  });
+
+  runner.run("MinoGrid::removeCompletedRows" + suffix, [&](long) {
+    MinoGrid copy = grid;
+    int lines = copy.removeCompletedRows();
+    keep(lines);
+    keep(copy);
+  });
+
+  runner.run("MinoGrid::addTetrimino" + suffix, [&](long i) {
+    MinoGrid copy = grid;
+    copy.addTetrimino(pieces[i & mask]);
+    keep(copy);
+  });
+
+  runner.run("MinoGrid::TetriminoOverlapping" + suffix, [&](long i) {
+    bool result = grid.TetriminoOverlapping(pieces[i & mask]);
+    keep(result);
+  });
+
+  runner.run("MinoGrid::isTouchingDown" + suffix, [&](long i) {
+    bool result = grid.isTouchingDown(pieces[i & mask]);
+    keep(result);
+  });
+
+  runner.run("MinoGrid::isTouchingLeft" + suffix, [&](long i) {
+    bool result = grid.isTouchingLeft(pieces[i & mask]);
+    keep(result);
+  });
+
+  runner.run("MinoGrid::isTouchingRight" + suffix, [&](long i) {
+    bool result = grid.isTouchingRight(pieces[i & mask]);
+    keep(result);
+  });
+
+  // The wall kicks, tried in the same order as when the player rotates
+  runner.run("MinoGrid::rotatePiece" + suffix, [&](long i) {
+    const Tetrimino &piece = pieces[i & mask];
+    int rotation = piece.getRotationIndex();
+    int col = piece.getCol();
+    int row = piece.getRow();
+
+    bool rotated = grid.rotatePiece(piece.getShape(), rotation, col, row, RIGHT);
+    keep(rotated);
+    keep(col);
+  });
+
+  // What the ghost piece and hard drops use, from the top of the playfield
+  runner.run("MinoGrid::getDropDistance" + suffix, [&](long i) {
+    Tetrimino piece = pieces[i & mask];
+    piece.setRow(0);
+    int distance = grid.getDropDistance(piece);
+    keep(distance);
+  });
+}
+
+static void benchBag(BenchRunner &runner) {
+  TetriminoBag bag(12345);
+
+  runner.run("TetriminoBag::getNextShape", [&](long) {
+    TETRIMINO_SHAPE shape = bag.getNextShape();
+    keep(shape);
+  });
+
+  runner.run("TetriminoBag::preview/5", [&](long) {
+    std::vector<TETRIMINO_SHAPE> shapes = bag.preview(5);
+    keep(shapes);
+  });
+
+  runner.run("TetriminoBag::preview(array)/5", [&](long) {
+    TETRIMINO_SHAPE shapes[5];
+    int count = bag.preview(shapes, 5);
+    keep(shapes);
+    keep(count);
+  });
+}
+
+static void printText(const std::vector<BenchResult> &results) {
+  printf("%-50s %12s %12s %14s\n", "benchmark", "ns/op", "allocs/op", "iterations");
+
+  for (const BenchResult &result : results) {
+    printf("%-50s %12.2f %12.2f %14ld\n", result.name.c_str(), result.nanosPerOp,
+           result.allocationsPerOp, result.iterations);
+  }
+}
+
+static void printJson(const std::vector<BenchResult> &results) {
+  printf("[\n");
+
+  for (size_t i = 0; i < results.size(); i++) {
+    const BenchResult &result = results[i];
+    printf("  {\"name\": \"%s\", \"ns_per_op\": %.3f, \"allocs_per_op\": %.3f, "
+           "\"iterations\": %ld}%s\n",
+           result.name.c_str(), result.nanosPerOp, result.allocationsPerOp, result.iterations,
+           i + 1 < results.size() ? "," : "");
+  }
+
+  printf("]\n");
+}
+
+int main(int argc, char **argv) {
+  std::string filter;
+  double minSeconds = 0.1;
+  bool json = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+      filter = argv[++i];
+    } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+      minSeconds = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--json") == 0) {
+      json = true;
+    } else {
+      fprintf(stderr, "Unknown option: %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  // Fixed seed, so every run benchmarks the same boards
+  std::mt19937 random(2024);
+
+  std::vector<Fixture> fixtures;
+  fixtures.push_back({"empty", MinoGrid(), makePieces(random)});
+  fixtures.back().grid.clear();
+  fixtures.push_back({"jagged", makeJagged(random), makePieces(random)});
+  fixtures.push_back({"near-full", makeNearFull(), makePieces(random)});
+  fixtures.push_back({"complete", makeComplete(), makePieces(random)});
+
+  BenchRunner runner(filter, minSeconds);
+
+  for (const Fixture &fixture : fixtures) {
+    benchFixture(runner, fixture);
+  }
+  benchBag(runner);
+
+  if (json) {
+    printJson(runner.getResults());
+  } else {
+    printText(runner.getResults());
+  }
+
+  return 0;
+}
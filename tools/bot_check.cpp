@@ -0,0 +1,140 @@
+// Checks that the bot lands pieces where it means to, also when gravity took a piece past its
+// target and the bot had to pick another one. The bot plans for each piece when it comes in, then
+// the piece is left to fall without any input until it touches down, and the bot plays it from
+// there. The piece has to lock exactly at the bot's target at that point.
+//
+//   riktris_bot_check [--boards <n>] [--seed <n>]
+//
+// The boards are random stacks with a wall somewhere in the middle, so that for a lot of pieces
+// the first target is on the other side of the wall once they get down to it. Exits with 1 if any
+// piece locks somewhere else.
+
+#include "core/bot.h"
+#include "core/game.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+// Ticks after which a piece that still hasn't locked counts as lost
+#define MAX_PIECE_TICKS 2000
+
+// Random columns of junk, and a wall reaching up to a few rows from the top
+static MinoGrid makeBoard(std::mt19937 &random) {
+  MinoGrid grid;
+  grid.clear();
+
+  int wallCol = 2 + random() % (GRID_WIDTH - 4);
+  int wallTop = 6 + random() % 6;
+
+  for (int col = 0; col < (int)GRID_WIDTH; col++) {
+    int top = col == wallCol ? wallTop : GRID_HEIGHT - random() % 5;
+
+    for (int row = top; row < (int)GRID_HEIGHT; row++) {
+      if (col == wallCol || random() % 4 != 0) {
+        grid.setCell(col, row, 1 + random() % NUMBER_OF_SHAPES);
+      }
+    }
+  }
+  return grid;
+}
+
+// Puts the given grid in place of the empty one of a new game
+static bool startOnBoard(Game &game, const MinoGrid &grid) {
+  ByteWriter state;
+  game.saveState(state);
+
+  ByteWriter emptyGrid;
+  game.getGrid().saveState(emptyGrid);
+
+  ByteWriter changed;
+  grid.saveState(changed);
+  changed.putBytes(state.bytes() + emptyGrid.size(), state.size() - emptyGrid.size());
+
+  ByteReader reader(changed.bytes(), changed.size());
+  return game.loadState(reader);
+}
+
+int main(int argc, char **argv) {
+  int boards = 1000;
+  uint64_t seed = 1;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--boards") == 0 && i + 1 < argc) {
+      boards = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = strtoull(argv[++i], nullptr, 10);
+    } else {
+      fprintf(stderr, "Unknown option: %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  BotConfig config;
+  config.timeBudgetMicros = 0; // The same searches on every run
+  std::mt19937 random(seed);
+
+  int checked = 0;
+  int replanned = 0;
+  int failed = 0;
+
+  for (int b = 0; b < boards; b++) {
+    Game game(seed + b);
+    if (!startOnBoard(game, makeBoard(random)) || game.isToppedOut()) {
+      continue;
+    }
+
+    // The bot picks a target for the new piece, then the piece falls on its own
+    Bot bot(config);
+    int firstRotation, firstCol, firstRow;
+    bot.nextInputs(game);
+    if (!bot.getTarget(firstRotation, firstCol, firstRow)) {
+      continue;
+    }
+
+    while (!game.getGrid().isTouchingDown(game.getCurrentTetrimino())) {
+      game.step(0);
+    }
+
+    // From here the bot plays the piece until it locks
+    MinoGrid before = game.getGrid();
+    Tetrimino piece = game.getCurrentTetrimino();
+    long pieceCount = game.getPieceCount();
+    int rotation, col, row;
+    bool hasTarget = false;
+
+    for (int tick = 0; tick < MAX_PIECE_TICKS && game.getPieceCount() == pieceCount &&
+                       !game.isClearingLines() && !game.isToppedOut();
+         tick++) {
+      uint8_t inputs = bot.nextInputs(game);
+      hasTarget = bot.getTarget(rotation, col, row);
+      game.step(inputs);
+    }
+
+    if (!hasTarget) {
+      continue;
+    }
+    checked++;
+    if (rotation != firstRotation || col != firstCol || row != firstRow) {
+      replanned++;
+    }
+
+    // The grid right after the lock, lines that are being cleared are still in it
+    Tetrimino target(piece.getShape());
+    target.setRotation(rotation);
+    target.setCol(col);
+    target.setRow(row);
+    MinoGrid expected = before;
+    expected.addTetrimino(target);
+
+    if (!(game.getGrid() == expected)) {
+      printf("board %d: the piece locked away from its target (rotation %d, col %d, row %d)\n", b,
+             rotation, col, row);
+      failed++;
+    }
+  }
+
+  printf("%d pieces checked, %d after picking another target, %d locked elsewhere\n", checked,
+         replanned, failed);
+  return failed > 0 ? 1 : 0;
+}
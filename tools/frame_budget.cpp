@@ -0,0 +1,224 @@
+// Plays scripted games in a hidden window, timing the Update and Draw of every frame, and fails
+// when the frames are slower than the budgets or allocate memory once the game is under way. The
+// frames go through SceneManager, like in the main loop.
+//
+//   riktris_frame_budget [--scenario <name>] [--frames <n>] [--p50 <ms>] [--p99 <ms>] [--max <ms>]
+//
+// The games are played by the bot with fixed seeds and settings, so every run plays exactly the
+// same frames. Frames are simulated at 60 per second (one tick each) but not waited for, a run
+// takes as long as the frames take to update and draw. Needs the game data files, like the game.
+
+#include "allocation_counter.h"
+#include "asset_loader.h"
+#include "globals.h"
+#include "launch_options.h"
+#include "scene_manager.h"
+#include "scenes/gameplay_scene.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <raylib.h>
+#include <string>
+#include <vector>
+
+#define FRAME_RATE 60
+
+// Frames after the start of a game that may still allocate (sounds and textures loaded the first
+// time they are used, and so on)
+#define WARMUP_FRAMES FRAME_RATE
+
+struct Scenario {
+  const char *name;
+  const char *description;
+  uint64_t seed;
+  long frames;
+  int startLevel; // The game is played without timing it until it gets to this level
+  BotConfig config;
+};
+
+struct FrameStats {
+  double p50, p99, max; // Milliseconds
+};
+
+static FrameStats getStats(std::vector<double> &times) {
+  std::sort(times.begin(), times.end());
+
+  auto percentile = [&](double p) { return times[(size_t)(p * (times.size() - 1))]; };
+  return {percentile(0.5), percentile(0.99), times.back()};
+}
+
+// Weights that go for tetrises: clearing fewer lines is punished and a well is welcome. The bot
+// tops out now and then like this, but the games restart and the stacks clear 4 lines at a time.
+static BotConfig getQuadConfig() {
+  BotConfig config;
+  config.timeBudgetMicros = 0;
+  config.weights.aggregateHeight = -0.2f;
+  config.weights.holes = -7.0f;
+  config.weights.bumpiness = -0.15f;
+  config.weights.wells = 0.3f;
+  config.weights.rowTransitions = -0.3f;
+  config.weights.columnTransitions = -0.3f;
+  config.weights.lineClears[1] = -12.0f;
+  config.weights.lineClears[2] = -10.0f;
+  config.weights.lineClears[3] = -8.0f;
+  config.weights.lineClears[4] = 50.0f;
+  return config;
+}
+
+static BotConfig getDefaultConfig() {
+  BotConfig config;
+  config.timeBudgetMicros = 0;
+  return config;
+}
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+int main(int argc, char **argv) {
+  std::string scenarioName;
+  long frames = 0;
+  double budgetP50 = 4.0;
+  double budgetP99 = 8.0;
+  double budgetMax = 1000.0 / FRAME_RATE;
+
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+
+    if (strcmp(argv[i], "--scenario") == 0 && hasValue) {
+      scenarioName = argv[++i];
+    } else if (strcmp(argv[i], "--frames") == 0 && hasValue) {
+      frames = atol(argv[++i]);
+    } else if (strcmp(argv[i], "--p50") == 0 && hasValue) {
+      budgetP50 = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--p99") == 0 && hasValue) {
+      budgetP99 = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--max") == 0 && hasValue) {
+      budgetMax = atof(argv[++i]);
+    } else {
+      fprintf(stderr, "Unknown option: %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  const Scenario scenarios[] = {
+      {"marathon", "a long game from level 1", 1, 10 * 60 * FRAME_RATE, 1, getDefaultConfig()},
+      {"quads", "tetris after tetris", 2, 3 * 60 * FRAME_RATE, 1, getQuadConfig()},
+      {"high-gravity", "from level 15 on", 3, 3 * 60 * FRAME_RATE, 15, getDefaultConfig()},
+  };
+
+  // The harness plays its own games, they aren't worth keeping
+  getLaunchOptions().record = false;
+  getLaunchOptions().tickRate = FRAME_RATE;
+
+  SetTraceLogLevel(LOG_WARNING | LOG_ERROR);
+  SetConfigFlags(FLAG_WINDOW_HIDDEN);
+  InitWindow(WINDOW_W, WINDOW_H, "Riktris frame budget");
+  InitAudioDevice();
+
+  mountAssets();
+
+  // Frames are drawn to a texture instead of the hidden window, nothing waits for the display
+  RenderTexture2D target = LoadRenderTexture(WINDOW_W, WINDOW_H);
+
+  bool failed = false;
+
+  printf("%-14s %8s %26s %26s %26s\n", "scenario", "frames", "update p50/p99/max (ms)",
+         "draw p50/p99/max (ms)", "frame p50/p99/max (ms)");
+
+  // The games are played in the scene the game starts with, the bot takes over its input
+  SceneManager &sceneManager = SceneManager::getInstance();
+  sceneManager.switchTo(GAMEPLAY_SCENE);
+  GameplayScene &scene = static_cast<GameplayScene &>(*sceneManager.getScene(GAMEPLAY_SCENE));
+
+  for (const Scenario &scenario : scenarios) {
+    if (!scenarioName.empty() && scenarioName != scenario.name) {
+      continue;
+    }
+
+    uint64_t seed = scenario.seed;
+
+    auto startGame = [&]() {
+      scene.startBotGame(seed++, scenario.config);
+
+      while (scene.getGame().getLevel() < scenario.startLevel && !scene.getGame().isToppedOut()) {
+        scene.Update();
+      }
+    };
+    startGame();
+
+    long frameCount = frames > 0 ? frames : scenario.frames;
+    std::vector<double> updateTimes, drawTimes, frameTimes;
+    updateTimes.reserve(frameCount);
+    drawTimes.reserve(frameCount);
+    frameTimes.reserve(frameCount);
+    int restarts = 0;
+    long warmupLeft = WARMUP_FRAMES;
+    long allocatingFrames = 0;
+    long maxAllocations = 0;
+
+    for (long frame = 0; frame < frameCount; frame++) {
+      // A topped out game is just the game over screen, start another one
+      if (scene.getGame().isToppedOut()) {
+        startGame();
+        restarts++;
+        warmupLeft = WARMUP_FRAMES;
+      }
+
+      long allocationsBefore = getAllocationCount();
+      auto start = std::chrono::steady_clock::now();
+      sceneManager.PollInput();
+      sceneManager.Update();
+      double update = millisecondsSince(start);
+
+      start = std::chrono::steady_clock::now();
+      BeginTextureMode(target);
+      sceneManager.Draw(0.0f);
+      EndTextureMode();
+      double draw = millisecondsSince(start);
+
+      long allocations = getAllocationCount() - allocationsBefore;
+      if (warmupLeft > 0) {
+        warmupLeft--;
+      } else if (allocations > 0) {
+        allocatingFrames++;
+        maxAllocations = std::max(maxAllocations, allocations);
+      }
+
+      updateTimes.push_back(update);
+      drawTimes.push_back(draw);
+      frameTimes.push_back(update + draw);
+    }
+
+    FrameStats update = getStats(updateTimes);
+    FrameStats draw = getStats(drawTimes);
+    FrameStats frame = getStats(frameTimes);
+
+    printf("%-14s %8ld %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f %8.3f\n", scenario.name,
+           frameCount, update.p50, update.p99, update.max, draw.p50, draw.p99, draw.max,
+           frame.p50, frame.p99, frame.max);
+    printf("  %s: %d restarts, the last game got to level %d with %d lines\n",
+           scenario.description, restarts, scene.getGame().getLevel(),
+           scene.getGame().getLinesCleared());
+
+    if (frame.p50 > budgetP50 || frame.p99 > budgetP99 || frame.max > budgetMax) {
+      printf("  OVER BUDGET (p50 %.3f, p99 %.3f, max %.3f ms)\n", budgetP50, budgetP99, budgetMax);
+      failed = true;
+    }
+
+    if (allocatingFrames > 0) {
+      printf("  ALLOCATING: %ld frames allocated after the warmup, up to %ld allocations in one\n",
+             allocatingFrames, maxAllocations);
+      failed = true;
+    }
+  }
+
+  UnloadRenderTexture(target);
+  CloseAudioDevice();
+  CloseWindow();
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+// Decodes images and sounds and writes them to an asset pack (see core/asset_pack.h), so the game
+// doesn't have to decode them every time it starts. It's run by the build, whenever an asset
+// changes.
+//
+//   riktris_pack <output>
+//
+// Only the assets in the scenes' manifests (SceneManager::getManifest) are packed, read from the
+// data directory under the current directory. They are named in the pack by the paths the game
+// loads them by ("data/gfx/mino_t.png"). Images become RGBA pixels, sounds keep the sample format
+// they are decoded to.
+
+#include "core/asset_pack.h"
+#include "scene_manager.h"
+#include "sound_manager.h"
+#include "texture_manager.h"
+#include <cstdio>
+#include <raylib.h>
+#include <set>
+#include <string>
+
+static bool hasExtension(const std::string &path, const char *extension) {
+  size_t dot = path.rfind('.');
+  return dot != std::string::npos && path.compare(dot, std::string::npos, extension) == 0;
+}
+
+static bool addImage(AssetPackWriter &pack, const std::string &path) {
+  Image image = LoadImage(path.c_str());
+  if (!image.data) {
+    return false;
+  }
+
+  // What the GPU takes without any conversion
+  ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+  uint32_t params[4] = {(uint32_t)image.width, (uint32_t)image.height, (uint32_t)image.format, 1};
+  pack.add(path, ASSET_IMAGE, params, image.data, (size_t)image.width * image.height * 4);
+
+  UnloadImage(image);
+  return true;
+}
+
+static bool addSound(AssetPackWriter &pack, const std::string &path) {
+  Wave wave = LoadWave(path.c_str());
+  if (!wave.data) {
+    return false;
+  }
+
+  uint32_t params[4] = {wave.frameCount, wave.sampleRate, wave.sampleSize, wave.channels};
+  size_t size = (size_t)wave.frameCount * wave.channels * wave.sampleSize / 8;
+  pack.add(path, ASSET_SOUND, params, wave.data, size);
+
+  UnloadWave(wave);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s <output>\n", argv[0]);
+    return 2;
+  }
+
+  SetTraceLogLevel(LOG_WARNING | LOG_ERROR);
+
+  // Several scenes can use the same file, it's packed once
+  std::set<std::string> paths;
+
+  for (int id = LOGO_SCENE; id <= PAUSE_SCENE; id++) {
+    AssetManifest manifest = SceneManager::getManifest((GameSceneId)id);
+
+    for (const std::string &filename : manifest.textures) {
+      paths.insert(TEXTURES_DIR + filename);
+    }
+    for (const std::string &filename : manifest.images) {
+      paths.insert(TEXTURES_DIR + filename);
+    }
+    for (const std::string &filename : manifest.sounds) {
+      paths.insert(SOUND_DIR + filename);
+    }
+  }
+
+  AssetPackWriter pack;
+
+  for (const std::string &path : paths) {
+    bool added;
+
+    if (hasExtension(path, ".png")) {
+      added = addImage(pack, path);
+    } else if (hasExtension(path, ".wav") || hasExtension(path, ".ogg") ||
+               hasExtension(path, ".mp3")) {
+      added = addSound(pack, path);
+    } else {
+      fprintf(stderr, "Don't know how to pack %s\n", path.c_str());
+      return 2;
+    }
+
+    if (!added) {
+      fprintf(stderr, "Could not decode %s\n", path.c_str());
+      return 1;
+    }
+  }
+
+  if (!pack.write(argv[1])) {
+    fprintf(stderr, "Could not write %s\n", argv[1]);
+    return 1;
+  }
+
+  printf("%zu assets packed into %s\n", pack.getCount(), argv[1]);
+  return 0;
+}
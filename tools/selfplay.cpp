@@ -0,0 +1,125 @@
+// Plays many games with the bot at the same time, one per core, and writes how each one ended.
+//
+//   riktris_selfplay [--games <n>] [--threads <n>] [--seed <n>] [--max-pieces <n>]
+//                    [--preview <n>] [--beam <n>] [--budget-us <n>] [--weights <file>]
+//                    [--output <file>] [--replays <directory>]
+//
+// With the default --budget-us 0 the bot has no time limit, so the same seeds always give the same
+// games, however many threads play them.
+
+#include "selfplay.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+int main(int argc, char **argv) {
+  long games = 100;
+  int threads = defaultThreadCount();
+  uint64_t firstSeed = 1;
+  long maxPieces = 10000;
+  std::string outputPath = "selfplay.csv";
+  std::string replaysDirectory;
+
+  BotConfig config;
+  config.timeBudgetMicros = 0;
+
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+
+    if (strcmp(argv[i], "--games") == 0 && hasValue) {
+      games = atol(argv[++i]);
+    } else if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+      threads = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+      firstSeed = strtoull(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--max-pieces") == 0 && hasValue) {
+      maxPieces = atol(argv[++i]);
+    } else if (strcmp(argv[i], "--preview") == 0 && hasValue) {
+      config.previewPieces = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--beam") == 0 && hasValue) {
+      config.beamWidth = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--budget-us") == 0 && hasValue) {
+      config.timeBudgetMicros = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--weights") == 0 && hasValue) {
+      if (!loadEvaluatorWeights(argv[++i], config.weights)) {
+        std::cerr << "Could not read weights from " << argv[i] << std::endl;
+        return 2;
+      }
+    } else if (strcmp(argv[i], "--output") == 0 && hasValue) {
+      outputPath = argv[++i];
+    } else if (strcmp(argv[i], "--replays") == 0 && hasValue) {
+      replaysDirectory = argv[++i];
+    } else {
+      std::cerr << "Unknown option: " << argv[i] << std::endl;
+      return 2;
+    }
+  }
+
+  FILE *output = fopen(outputPath.c_str(), "w");
+  if (!output) {
+    std::cerr << "Could not write to " << outputPath << std::endl;
+    return 2;
+  }
+
+  if (!replaysDirectory.empty()) {
+    std::error_code error;
+    std::filesystem::create_directories(replaysDirectory, error);
+  }
+
+  // Results are written as soon as each game ends, in whatever order they finish
+  fprintf(output, "seed,pieces,lines,score,level,ticks,topped_out\n");
+  std::mutex outputMutex;
+
+  std::atomic<long> totalPieces{0};
+  std::atomic<long> totalLines{0};
+  std::atomic<long> toppedOut{0};
+
+  auto start = std::chrono::steady_clock::now();
+
+  ThreadPool pool(threads);
+
+  for (long i = 0; i < games; i++) {
+    pool.submit([&, i](int) {
+      uint64_t seed = firstSeed + i;
+      std::string replayPath;
+
+      if (!replaysDirectory.empty()) {
+        replayPath = replaysDirectory + "/" + std::to_string(seed) + ".rkr";
+      }
+
+      SelfPlayResult result = playGame(seed, config, maxPieces, replayPath);
+
+      totalPieces += result.pieces;
+      totalLines += result.lines;
+      toppedOut += result.toppedOut;
+
+      std::lock_guard<std::mutex> lock(outputMutex);
+      fprintf(output, "%llu,%ld,%d,%ld,%d,%ld,%d\n", (unsigned long long)result.seed,
+              result.pieces, result.lines, result.score, result.level, result.ticks,
+              result.toppedOut);
+      fflush(output);
+    });
+  }
+
+  pool.wait();
+  fclose(output);
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::cout << "games:   " << games << " on " << threads << " threads in " << elapsed.count()
+            << "s (" << games / elapsed.count() << " games/s)" << std::endl;
+  std::cout << "pieces:  " << totalPieces << " (" << (long)(totalPieces / elapsed.count())
+            << " pieces/s)" << std::endl;
+  std::cout << "lines:   " << totalLines << ", " << toppedOut << " games topped out" << std::endl;
+  std::cout << "results: " << outputPath << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "core/bot.h"
+#include "core/game.h"
+#include "core/replay.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+// How a game played by the bot ended
+struct SelfPlayResult {
+  uint64_t seed = 0;
+  long pieces = 0;
+  long ticks = 0;
+  long score = 0;
+  int lines = 0;
+  int level = 0;
+  bool toppedOut = false;
+};
+
+// Plays a whole game with the bot, until it tops out or maxPieces pieces have been placed (0 for
+// no limit). Every game has its own Game and Bot, so any number of them can be played at the same
+// time. The game is recorded to replayPath, unless it's empty.
+inline SelfPlayResult playGame(uint64_t seed, const BotConfig &config, long maxPieces,
+                               const std::string &replayPath = "") {
+  Game game(seed);
+  Bot bot(config);
+  ReplayRecorder recorder;
+
+  if (!replayPath.empty() && !recorder.open(replayPath, game, seed)) {
+    std::cerr << "Could not record the game to " << replayPath << std::endl;
+  }
+
+  // The piece count includes the piece in play, it goes over maxPieces once that many are placed
+  while (!game.isToppedOut() && (maxPieces <= 0 || game.getPieceCount() <= maxPieces)) {
+    uint8_t inputs = bot.nextInputs(game);
+
+    recorder.record(game, inputs);
+    game.step(inputs);
+  }
+
+  if (recorder.isRecording()) {
+    recorder.finish(game);
+  }
+
+  SelfPlayResult result;
+  result.seed = seed;
+  result.pieces = game.getPieceCount() - 1; // The last one came in but wasn't placed
+  result.ticks = game.getTickCount();
+  result.score = game.getScore();
+  result.lines = game.getLinesCleared();
+  result.level = game.getLevel();
+  result.toppedOut = game.isToppedOut();
+  return result;
+}
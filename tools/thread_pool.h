@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Number of worker threads to use when none is given: one per core
+inline int defaultThreadCount() {
+  unsigned int cores = std::thread::hardware_concurrency();
+  return cores > 0 ? cores : 1;
+}
+
+// A pool of worker threads with a queue of tasks each. Tasks are spread over the queues as they
+// are submitted, every worker runs its own tasks newest first and, when it runs out, steals the
+// oldest task of another worker. Games take very different times to play, so without stealing
+// the workers that got the short ones would sit idle at the end.
+class ThreadPool {
+public:
+  // The task gets the index of the worker running it, in [0, getThreadCount())
+  typedef std::function<void(int worker)> Task;
+
+private:
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  std::vector<std::thread> threads;
+  std::atomic<size_t> nextQueue{0};
+
+  std::mutex stateMutex;
+  std::condition_variable workAvailable;
+  std::condition_variable allDone;
+  long queuedTasks = 0;  // Submitted and not started yet
+  long pendingTasks = 0; // Submitted and not finished yet
+  bool stopping = false;
+
+  bool popOwn(int worker, Task &task) {
+    WorkerQueue &queue = *queues[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty()) {
+      return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+  }
+
+  bool steal(int worker, Task &task) {
+    for (size_t i = 1; i < queues.size(); i++) {
+      WorkerQueue &queue = *queues[(worker + i) % queues.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+
+      if (!queue.tasks.empty()) {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void run(int worker) {
+    Task task;
+
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        workAvailable.wait(lock, [this] { return stopping || queuedTasks > 0; });
+
+        if (queuedTasks == 0) {
+          return; // Stopping and nothing left to do
+        }
+        queuedTasks--;
+      }
+
+      // There is a task for us somewhere, since we took one from the count
+      while (!popOwn(worker, task) && !steal(worker, task)) {
+        std::this_thread::yield();
+      }
+
+      task(worker);
+      task = nullptr;
+
+      std::lock_guard<std::mutex> lock(stateMutex);
+      if (--pendingTasks == 0) {
+        allDone.notify_all();
+      }
+    }
+  }
+
+public:
+  explicit ThreadPool(int threadCount = defaultThreadCount()) {
+    for (int i = 0; i < threadCount; i++) {
+      queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 0; i < threadCount; i++) {
+      threads.emplace_back(&ThreadPool::run, this, i);
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      stopping = true;
+    }
+    workAvailable.notify_all();
+
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  int getThreadCount() const { return threads.size(); }
+
+  void submit(Task task) {
+    WorkerQueue &queue = *queues[nextQueue++ % queues.size()];
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      queuedTasks++;
+      pendingTasks++;
+    }
+    workAvailable.notify_one();
+  }
+
+  // Blocks until every task submitted so far has finished
+  void wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    allDone.wait(lock, [this] { return pendingTasks == 0; });
+  }
+};
+
+// Calls job(index, worker) for every index in [0, count), on a pool with the given number of
+// threads. worker is in [0, threads) and can be used to index per-thread results without locking.
+inline void parallelFor(size_t count, int threads,
+                        const std::function<void(size_t index, int worker)> &job) {
+  ThreadPool pool(threads);
+
+  for (size_t index = 0; index < count; index++) {
+    pool.submit([&job, index](int worker) { job(index, worker); });
+  }
+
+  pool.wait();
+}
@@ -0,0 +1,193 @@
+// Searches for better evaluation weights for the bot by having it play lots of games with each
+// candidate set of weights.
+//
+//   riktris_tune [--generations <n>] [--population <n>] [--elite <n>] [--games <n>]
+//                [--max-pieces <n>] [--sigma <x>] [--seed <n>] [--threads <n>]
+//                [--preview <n>] [--beam <n>] [--weights <file>] [--output <file>]
+//
+// It's a simple evolution strategy: the weights are drawn from a normal distribution around a mean,
+// every candidate plays the same games and is ranked by its average score, and the mean and spread
+// of the best ones (the elite) become the distribution of the next generation. The mean is written
+// to the output after every generation, so the tuner can be stopped at any time.
+//
+// Every generation plays population * games games, which makes it a good benchmark of the game code
+// too: the pieces per second of each generation are printed along with the scores.
+
+#include "selfplay.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+// Smallest spread a weight can have, so the search never stops exploring it
+#define MIN_SIGMA 0.01f
+
+int main(int argc, char **argv) {
+  int generations = 20;
+  int population = 16;
+  int elite = 4;
+  int games = 32;
+  long maxPieces = 500;
+  float sigma = 0.5f;
+  uint64_t seed = 1;
+  int threads = defaultThreadCount();
+  std::string weightsPath;
+  std::string outputPath = "weights.txt";
+
+  BotConfig config;
+  config.previewPieces = 1;
+  config.beamWidth = 4;
+  config.timeBudgetMicros = 0;
+
+  for (int i = 1; i < argc; i++) {
+    bool hasValue = i + 1 < argc;
+
+    if (strcmp(argv[i], "--generations") == 0 && hasValue) {
+      generations = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--population") == 0 && hasValue) {
+      population = std::max(2, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--elite") == 0 && hasValue) {
+      elite = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--games") == 0 && hasValue) {
+      games = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--max-pieces") == 0 && hasValue) {
+      maxPieces = atol(argv[++i]);
+    } else if (strcmp(argv[i], "--sigma") == 0 && hasValue) {
+      sigma = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--seed") == 0 && hasValue) {
+      seed = strtoull(argv[++i], nullptr, 10);
+    } else if (strcmp(argv[i], "--threads") == 0 && hasValue) {
+      threads = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--preview") == 0 && hasValue) {
+      config.previewPieces = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--beam") == 0 && hasValue) {
+      config.beamWidth = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--weights") == 0 && hasValue) {
+      weightsPath = argv[++i];
+    } else if (strcmp(argv[i], "--output") == 0 && hasValue) {
+      outputPath = argv[++i];
+    } else {
+      std::cerr << "Unknown option: " << argv[i] << std::endl;
+      return 2;
+    }
+  }
+
+  elite = std::min(elite, population);
+
+  EvaluatorWeights mean;
+  if (!weightsPath.empty() && !loadEvaluatorWeights(weightsPath, mean)) {
+    std::cerr << "Could not read weights from " << weightsPath << std::endl;
+    return 2;
+  }
+
+  // The spread starts relative to each weight, they are on very different scales
+  float sigmas[EVALUATOR_WEIGHT_COUNT];
+  for (int w = 0; w < EVALUATOR_WEIGHT_COUNT; w++) {
+    sigmas[w] = sigma * std::max(std::fabs(getWeight(mean, w)), 0.5f);
+  }
+
+  // Clearing nothing is the baseline every other reward is relative to, it isn't tuned
+  sigmas[6] = 0.0f;
+
+  std::mt19937_64 random(seed);
+  std::normal_distribution<float> normal(0.0f, 1.0f);
+
+  ThreadPool pool(threads);
+
+  std::vector<EvaluatorWeights> candidates(population);
+  // Results of every game of every candidate, each task writes its own slot
+  std::vector<long> scores(population * games);
+  std::vector<long> pieces(population * games);
+  std::vector<int> order(population);
+  std::vector<double> fitness(population);
+
+  for (int generation = 0; generation < generations; generation++) {
+    // The first candidate is the mean itself, to see how the distribution is doing
+    candidates[0] = mean;
+    for (int c = 1; c < population; c++) {
+      candidates[c] = mean;
+      for (int w = 0; w < EVALUATOR_WEIGHT_COUNT; w++) {
+        getWeight(candidates[c], w) += sigmas[w] * normal(random);
+      }
+    }
+
+    // Every candidate plays the same seeds, so luck with the pieces doesn't pick the winner. The
+    // seeds change between generations so the weights don't get tuned to a few games.
+    uint64_t firstSeed = seed + (uint64_t)generation * games;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int c = 0; c < population; c++) {
+      for (int g = 0; g < games; g++) {
+        pool.submit([&, c, g](int) {
+          BotConfig candidateConfig = config;
+          candidateConfig.weights = candidates[c];
+
+          SelfPlayResult result = playGame(firstSeed + g, candidateConfig, maxPieces);
+          scores[c * games + g] = result.score;
+          pieces[c * games + g] = result.pieces;
+        });
+      }
+    }
+    pool.wait();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    long totalPieces = std::accumulate(pieces.begin(), pieces.end(), 0L);
+
+    // Games stop at maxPieces, and most don't top out before that with any sensible weights, so
+    // lines cleared would be about the same for everyone. The score also rewards clearing them
+    // several at a time.
+    for (int c = 0; c < population; c++) {
+      auto first = scores.begin() + c * games;
+      fitness[c] = (double)std::accumulate(first, first + games, 0L) / games;
+    }
+
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return fitness[a] > fitness[b]; });
+
+    // The next distribution is centered on the elite, as wide as the elite is spread out
+    for (int w = 0; w < EVALUATOR_WEIGHT_COUNT; w++) {
+      if (sigmas[w] == 0.0f) {
+        continue;
+      }
+
+      float sum = 0.0f;
+      for (int e = 0; e < elite; e++) {
+        sum += getWeight(candidates[order[e]], w);
+      }
+      float average = sum / elite;
+
+      float variance = 0.0f;
+      for (int e = 0; e < elite; e++) {
+        float difference = getWeight(candidates[order[e]], w) - average;
+        variance += difference * difference;
+      }
+
+      getWeight(mean, w) = average;
+      sigmas[w] = std::max(std::sqrt(variance / elite), MIN_SIGMA);
+    }
+
+    printf("generation %d: best %.0f points, mean weights %.0f points, %.0f pieces/s\n", generation,
+           fitness[order[0]], fitness[0], totalPieces / elapsed.count());
+    fflush(stdout);
+
+    if (!saveEvaluatorWeights(outputPath, mean)) {
+      std::cerr << "Could not write weights to " << outputPath << std::endl;
+      return 1;
+    }
+  }
+
+  printf("weights written to %s\n", outputPath.c_str());
+  for (int w = 0; w < EVALUATOR_WEIGHT_COUNT; w++) {
+    printf("  %s %g\n", getWeightName(w), getWeight(mean, w));
+  }
+
+  return 0;
+}
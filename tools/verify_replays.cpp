@@ -0,0 +1,208 @@
+// Re-simulates a directory of replays with the headless rules, checks that every recorded result
+// (score, lines, level, pieces...) is what the rules really produce, and prints statistics about
+// the games.
+//
+//   riktris_verify <directory> [--threads <n>] [--quiet]
+
+#include "core/game.h"
+#include "core/replay.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct VerifyStats {
+  long games = 0;
+  long mismatched = 0;
+  long unreadable = 0;
+
+  long ticks = 0;
+  long pieces = 0;
+  double seconds = 0; // Game time
+  long lineClears[5] = {};
+  long toppedOut = 0;
+  long topOutHeights[GRID_HEIGHT + 1] = {};
+
+  void add(const VerifyStats &other) {
+    games += other.games;
+    mismatched += other.mismatched;
+    unreadable += other.unreadable;
+    ticks += other.ticks;
+    pieces += other.pieces;
+    seconds += other.seconds;
+    toppedOut += other.toppedOut;
+
+    for (int i = 0; i < 5; i++) {
+      lineClears[i] += other.lineClears[i];
+    }
+    for (int i = 0; i <= GRID_HEIGHT; i++) {
+      topOutHeights[i] += other.topOutHeights[i];
+    }
+  }
+};
+
+// Rows between the floor and the highest square of the stack
+static int stackHeight(const MinoGrid &grid) {
+  for (int row = 0; row < GRID_HEIGHT; row++) {
+    if (grid.getRowMask(row) != ROW_EMPTY) {
+      return GRID_HEIGHT - row;
+    }
+  }
+  return 0;
+}
+
+// Returns an empty string when the replay is fine, what's wrong with it otherwise
+static std::string verifyReplay(const std::string &path, VerifyStats &stats) {
+  Replay replay;
+  if (!replay.open(path)) {
+    stats.unreadable++;
+    return "not a valid replay";
+  }
+
+  Game game = replay.createGame();
+  ReplayPlayer player(replay);
+
+  while (!player.isFinished() && !game.isToppedOut()) {
+    uint32_t events = game.step(player.nextInputs(game));
+
+    if (events & EVENT_LINE_CLEAR) {
+      stats.lineClears[game.getClearingRows().size()]++;
+    }
+  }
+
+  stats.games++;
+  stats.ticks += game.getTickCount();
+  stats.pieces += game.getPieceCount();
+  stats.seconds += game.ticksToSeconds(game.getTickCount());
+
+  if (game.isToppedOut()) {
+    stats.toppedOut++;
+    stats.topOutHeights[stackHeight(game.getGrid())]++;
+  }
+
+  const ReplaySummary &summary = replay.getSummary();
+  std::string error;
+
+  if (summary.ticks != game.getTickCount())
+    error += " ticks " + std::to_string(summary.ticks) + "/" + std::to_string(game.getTickCount());
+  if (summary.pieces != game.getPieceCount())
+    error += " pieces " + std::to_string(summary.pieces) + "/" +
+             std::to_string(game.getPieceCount());
+  if (summary.score != game.getScore())
+    error += " score " + std::to_string(summary.score) + "/" + std::to_string(game.getScore());
+  if (summary.lines != game.getLinesCleared())
+    error += " lines " + std::to_string(summary.lines) + "/" +
+             std::to_string(game.getLinesCleared());
+  if (summary.level != game.getLevel())
+    error += " level " + std::to_string(summary.level) + "/" + std::to_string(game.getLevel());
+  if (summary.toppedOut != game.isToppedOut())
+    error += " topped out " + std::to_string(summary.toppedOut) + "/" +
+             std::to_string(game.isToppedOut());
+
+  if (!error.empty()) {
+    stats.mismatched++;
+    return "recorded/simulated" + error;
+  }
+
+  return "";
+}
+
+static void printStats(const VerifyStats &stats, double elapsed, int threads) {
+  const char *clearNames[5] = {"", "singles", "doubles", "triples", "tetrises"};
+  long totalClears = 0;
+
+  for (int i = 1; i <= 4; i++) {
+    totalClears += stats.lineClears[i];
+  }
+
+  std::cout << "games:        " << stats.games << " simulated, " << stats.mismatched
+            << " mismatched, " << stats.unreadable << " unreadable" << std::endl;
+  std::cout << "simulated:    " << stats.ticks << " ticks in " << elapsed << "s on " << threads
+            << " threads (" << (long)(stats.games / elapsed) << " games/s, "
+            << (long)(stats.ticks / elapsed) << " ticks/s)" << std::endl;
+  std::cout << "game time:    " << stats.seconds << "s, " << stats.pieces << " pieces ("
+            << (stats.seconds > 0 ? stats.pieces / stats.seconds : 0) << " pieces/s)" << std::endl;
+
+  std::cout << "line clears:  " << totalClears << std::endl;
+  for (int i = 1; i <= 4; i++) {
+    std::cout << "  " << clearNames[i] << ": " << stats.lineClears[i] << " ("
+              << (totalClears > 0 ? 100.0 * stats.lineClears[i] / totalClears : 0) << "%)"
+              << std::endl;
+  }
+
+  std::cout << "topped out:   " << stats.toppedOut << std::endl;
+  for (int height = 0; height <= GRID_HEIGHT; height++) {
+    if (stats.topOutHeights[height] > 0) {
+      std::cout << "  height " << height << ": " << stats.topOutHeights[height] << std::endl;
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  std::string directory;
+  int threads = defaultThreadCount();
+  bool quiet = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      threads = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--quiet") == 0) {
+      quiet = true;
+    } else {
+      directory = argv[i];
+    }
+  }
+
+  if (directory.empty()) {
+    std::cerr << "Usage: " << argv[0] << " <directory> [--threads <n>] [--quiet]" << std::endl;
+    return 2;
+  }
+
+  std::vector<std::string> paths;
+  std::error_code error;
+
+  for (auto it = std::filesystem::recursive_directory_iterator(directory, error);
+       it != std::filesystem::recursive_directory_iterator(); it.increment(error)) {
+    if (it->is_regular_file() && it->path().extension() == ".rkr") {
+      paths.push_back(it->path().string());
+    }
+  }
+
+  if (error) {
+    std::cerr << "Could not read " << directory << ": " << error.message() << std::endl;
+    return 2;
+  }
+
+  std::vector<VerifyStats> workerStats(threads);
+  std::vector<std::string> errors(paths.size());
+
+  auto start = std::chrono::steady_clock::now();
+
+  parallelFor(paths.size(), threads, [&](size_t index, int worker) {
+    errors[index] = verifyReplay(paths[index], workerStats[worker]);
+  });
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  VerifyStats stats;
+  for (const VerifyStats &worker : workerStats) {
+    stats.add(worker);
+  }
+
+  if (!quiet) {
+    for (size_t i = 0; i < paths.size(); i++) {
+      if (!errors[i].empty()) {
+        std::cout << paths[i] << ": " << errors[i] << std::endl;
+      }
+    }
+  }
+
+  printStats(stats, elapsed.count(), threads);
+
+  return stats.mismatched == 0 && stats.unreadable == 0 ? 0 : 1;
+}